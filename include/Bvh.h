@@ -0,0 +1,63 @@
+#pragma once
+
+#include <vector>
+#include <limits>
+#include "../include/Vector3.h"
+#include "../include/Mesh.h"
+#include "../include/CpuDispatch.h"
+
+namespace Shika {
+
+    // --- Bounding Volume Hierarchy ---
+    // Binned SAH build over the Mesh triangles, collapsed into 8-wide nodes.
+    // Queries run on the SIMD kernels (8 boxes / 8 triangles per step, KernelTable::IntersectRays).
+    // Static : rebuild after the mesh changes.
+    class Bvh {
+        public:
+           Bvh() = default;
+           explicit Bvh(const Mesh& mesh, int threadCount = 1) { Build(mesh, threadCount); }
+
+           // threadCount > 1 : the top subtrees are built on worker threads (same tree as single threaded)
+           void Build(const Mesh& mesh, int threadCount = 1);
+
+           // direction does not need to be normalized (t is in units of direction)
+           static BvhRay MakeRay(const Vector3& origin, const Vector3& direction,
+                                 float tMin = 0.0f, float tMax = std::numeric_limits<float>::infinity()) {
+               return { origin.x, origin.y, origin.z, tMin, direction.x, direction.y, direction.z, tMax };
+           }
+
+           // --- Queries ---
+           // Closest hit (double sided), hit.triangle = -1 on miss
+           bool Intersect(const BvhRay& ray, BvhHit& hit) const {
+               GetKernels().IntersectRays(View(), &ray, &hit, 1);
+               return hit.triangle >= 0;
+           }
+
+           // Any hit in (tMin, tMax) : line of sight / shadow rays
+           bool Occluded(const BvhRay& ray) const {
+               uint8_t occluded;
+               GetKernels().OccludedRays(View(), &ray, &occluded, 1);
+               return occluded != 0;
+           }
+
+           // Batch queries : one kernel call for the whole ray packet
+           void Intersect(const BvhRay* rays, BvhHit* hits, size_t count) const {
+               GetKernels().IntersectRays(View(), rays, hits, count);
+           }
+
+           void Occluded(const BvhRay* rays, uint8_t* occluded, size_t count) const {
+               GetKernels().OccludedRays(View(), rays, occluded, count);
+           }
+
+           BvhView View() const { return { nodes.data(), leaves.data(), nodes.size() }; }
+
+           size_t NodeCount() const { return nodes.size(); }
+           size_t LeafCount() const { return leaves.size(); }
+           size_t TriangleCount() const { return triangleCount; }
+
+        private:
+           std::vector<BvhNode8> nodes;
+           std::vector<BvhTriangles8> leaves;
+           size_t triangleCount = 0;
+    };
+}
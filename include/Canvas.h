@@ -6,6 +6,9 @@
 #include <iostream>
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include "CpuDispatch.h"
+#include "RenderStats.h"
 
 namespace Shika {
 
@@ -73,24 +76,35 @@ namespace Shika {
                    return false; 
                }
 
+               // float(0.0~1.0) -> int (0~255)
+               std::vector<uint8_t> rgb;
+               ConvertToRGB8(rgb);
+
                // Write a header
                ofs << "P3\n" << width << " " << height << "\n255\n";
 
                // Write Pixel data
-               for (const auto& p : pixels) {
-                   // float(0.0~1.0) -> int (0~255) 
-                   int ir = static_cast<int>(std::clamp(p.r, 0.0f, 1.0f) * 255.99f);
-                   int ig = static_cast<int>(std::clamp(p.g, 0.0f, 1.0f) * 255.99f);
-                   int ib = static_cast<int>(std::clamp(p.b, 0.0f, 1.0f) * 255.99f);
-               
-                   ofs << ir << " " << ig << " " << ib << "\n";
-                }
+               for (size_t i = 0; i < rgb.size(); i += 3) {
+                   ofs << (int)rgb[i] << " " << (int)rgb[i + 1] << " " << (int)rgb[i + 2] << "\n";
+               }
 
                 ofs.close();
                 std::cout << "Image saved to" << filename << " (" << width << "x" << height << ")" << std::endl;
                 return true;
            }
 
+           // 8-bit RGB framebuffer (SIMD kernel of the selected ISA)
+           void ConvertToRGB8(std::vector<uint8_t>& out) const {
+               SHIKA_STATS_SCOPE(RenderStage::Resolve);
+               out.resize(pixels.size() * 3);
+               GetKernels().ConvertRGB8(reinterpret_cast<const float*>(pixels.data()), out.data(), pixels.size());
+           }
+
+           // Raw buffer access for the raster kernels (row-major, width * height)
+           float* DepthData() { return zBuffer.data(); }
+           Color* PixelData() { return pixels.data(); }
+           const Color* PixelData() const { return pixels.data(); }
+
            int GetWidth() const {return width; }
            int GetHeight() const {return height; }
 
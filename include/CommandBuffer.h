@@ -0,0 +1,89 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include "../include/Canvas.h"
+#include "../include/Matrix4x4.h"
+#include "../include/Mesh.h"
+#include "../include/Texture.h"
+#include "../include/FrameArena.h"
+
+namespace Shika {
+
+    // --- Draw Command Buffer ---
+    // Records draws instead of rasterizing them immediately. Execute sorts every triangle with an
+    // LSD radix sort on a 64-bit key, most significant first :
+    //   depth bucket (SetDepthBits) | material (16 bits) | textured (1 bit) | depth (15 bits) | stream (16 bits)
+    // depth : nearest vertex of the triangle, quantized over the depth range of the frame. The buckets
+    // hold the same number of triangles each. All geometry is opaque (no blending) : buckets run
+    // front-to-back, triangles of one material stay front-to-back inside a bucket, and the depth test
+    // rejects hidden pixels. stream : the draw for textured materials (per-draw uvs), shared by all flat
+    // geometry, so the flat triangles of a material merge into one batch across draws (Rasterizer::DrawTriangles).
+    class CommandBuffer {
+        public:
+           static constexpr size_t MaxMaterials = 65536;
+           static constexpr size_t MaxDraws = 65534; // the last two draw ids hold the loose triangles
+
+           // --- Materials ---
+           // Index for Submit, -1 when the table is full (kept across Reset)
+           int AddMaterial(Color color);
+           int AddMaterial(const Texture& texture, Color tint = Color::White());
+           void ClearMaterials() { materials.clear(); }
+
+           // --- Recording ---
+           // Mesh draw (mesh & texture must stay alive until Execute), false if the buffer is full
+           // Textured materials fall back to the flat tint when the mesh has no uvs
+           bool Submit(const Mesh& mesh, const Matrix4x4& mvpMatrix, int material);
+
+           // Screen space triangle (TransformVertex output), the flat version ignores the material texture
+           bool SubmitTriangle(const Vector3& v0, const Vector3& v1, const Vector3& v2, int material);
+           bool SubmitTriangle(const Vector3& v0, const Vector3& v1, const Vector3& v2,
+                               TexCoord t0, TexCoord t1, TexCoord t2, int material);
+
+           // Depth buckets above the material in the key (1 - 16 bits)
+           // Fewer bits : coarser front-to-back order, fewer batches (at most materials x buckets when flat)
+           void SetDepthBits(int bits) { depthBits = bits < 1 ? 1 : (bits > 16 ? 16 : bits); }
+
+           // --- Execution ---
+           // Transform, sort & draw every recorded command (transient buffers come from the arena)
+           // The commands stay recorded : Reset before recording the next frame
+           void Execute(Canvas& canvas, LinearArena& arena);
+
+           // Drop the recorded commands (keeps the capacity)
+           void Reset();
+
+           size_t DrawCount() const { return draws.size(); }
+           size_t LooseTriangleCount() const { return flatTriangles.size() + texturedTriangles.size(); }
+
+           // Result of the last Execute
+           size_t SortedTriangles() const { return sortedTriangles; } // after backface culling
+           size_t BatchCount() const { return batchCount; }
+
+        private:
+           struct Material {
+               const Texture* texture;
+               Color color;
+           };
+
+           struct Draw {
+               const Mesh* mesh;
+               Matrix4x4 mvp;
+               int material;
+           };
+
+           struct LooseTriangle {
+               Vector3 v[3];
+               TexCoord t[3];
+               int material;
+           };
+
+           std::vector<Material> materials;
+           std::vector<Draw> draws;
+           std::vector<LooseTriangle> flatTriangles;
+           std::vector<LooseTriangle> texturedTriangles;
+           int depthBits = 4;
+
+           size_t sortedTriangles = 0;
+           size_t batchCount = 0;
+    };
+}
@@ -22,4 +22,10 @@ namespace Shika {
         return rad * (180.0f / PI);
     }
 
+    // a * b + c, never fused : inline headers must compile the same in every translation unit
+    // (the FMA kernels keep their own MulAdd, see src/kernels)
+    inline __m128 MulAdd(__m128 a, __m128 b, __m128 c) {
+        return _mm_add_ps(_mm_mul_ps(a, b), c);
+    }
+
 }
\ No newline at end of file
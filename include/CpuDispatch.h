@@ -0,0 +1,179 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Shika {
+
+    // Instruction set levels the hot kernels are compiled for.
+    // SSE4.1 is the baseline required by the inline math headers (_mm_dp_ps).
+    enum class SimdLevel : int {
+        SSE41  = 0,
+        AVX2   = 1, // AVX2 + FMA + F16C
+        AVX512 = 2  // AVX-512F
+    };
+
+    // Incremental edge/depth values of one raster row.
+    // w0..w2 and z are sampled at the first pixel centre, d* are the +1 pixel steps in x.
+    struct RasterRowSetup {
+        float w0, w1, w2;
+        float dw0, dw1, dw2;
+        float z, dz;
+    };
+
+    // Setup record of one visible triangle (KernelTable::SetupTriangles), vertices in screen space.
+    // Edge i : w_i(p) = (p.x - x[o]) * dwdx[i] + (p.y - y[o]) * dwdy[i], origins o = 1, 2, 0
+    // (edge 0 : v1 -> v2, 1 : v2 -> v0, 2 : v0 -> v1), a pixel is inside when all three are <= 0.
+    struct TriangleSetup {
+        float x[3], y[3], z[3];
+        float q[3];                   // 1 / w (pad lane of the screen vertices)
+        float dwdx[3], dwdy[3];
+        float area;                   // signed, < 0 (front facing)
+        int32_t minX, minY, maxX, maxY; // bounding box clipped to the target (inclusive)
+        uint32_t triangle;            // index in the input triangle list
+    };
+
+    // Rejected triangles of a SetupTriangles call (each one counted once, in this order)
+    struct TriangleSetupCounts {
+        uint32_t zeroArea;
+        uint32_t backface;
+        uint32_t frustum;  // bounding box outside the target
+        uint32_t subPixel; // no pixel centre inside the bounding box
+    };
+
+    // Optional per-row statistics filled by the raster kernel (instrumentation builds)
+    struct RasterRowStats {
+        uint32_t covered;      // pixels passing the edge test
+        uint16_t* overdrawRow; // per-pixel write counters of the span, saturating (nullable)
+    };
+
+    // Perspective correct texture coordinates of one raster row (Texture.h).
+    // u, v are premultiplied by q = 1 / w, all three are linear in screen space.
+    struct TexturedRowSetup {
+        float u, v, q;          // at the first pixel centre
+        float dudx, dvdx, dqdx; // +1 pixel in x
+        float dudy, dvdy, dqdy; // +1 pixel in y (mip level selection)
+    };
+
+    // --- Texture Layout (Texture.h) ---
+    // Texels are RGBA8 (r in the low byte), every mip level in one array
+    struct TextureView {
+        const uint32_t* texels;
+        int32_t levelCount;
+        int32_t layout;         // TextureLayout
+        int32_t filter;         // TextureFilter
+        int32_t wrap;           // TextureWrap
+        int32_t offset[16];     // first texel of each level
+        int32_t width[16];
+        int32_t height[16];
+        int32_t mortonMask[16]; // Morton : (1 << interleaved bits) - 1, the rest of the longer side sits above
+    };
+
+    // --- BVH Layout (Bvh.h) ---
+    // 8-wide node, child bounds in SoA so one ray is tested against all children at once
+    struct alignas(32) BvhNode8 {
+        float minX[8], minY[8], minZ[8];
+        float maxX[8], maxY[8], maxZ[8];
+        int32_t child[8]; // >= 0 : inner node index, < 0 : leaf (~index into the triangle blocks)
+    };
+
+    // Leaf : up to 8 triangles in SoA (vertex 0 + edges for Moller-Trumbore)
+    // Unused lanes have zero edges and triangle = -1
+    struct alignas(32) BvhTriangles8 {
+        float v0x[8], v0y[8], v0z[8];
+        float e1x[8], e1y[8], e1z[8];
+        float e2x[8], e2y[8], e2z[8];
+        int32_t triangle[8];
+    };
+
+    // Deepest inner node path the traversal kernels support (Bvh::Build stays below it)
+    constexpr int BvhMaxDepth = 128;
+
+    struct BvhView {
+        const BvhNode8* nodes;        // root : nodes[0]
+        const BvhTriangles8* leaves;
+        size_t nodeCount;             // 0 : empty tree
+    };
+
+    // Hits are accepted in (tMin, tMax)
+    struct BvhRay {
+        float ox, oy, oz, tMin;
+        float dx, dy, dz, tMax;
+    };
+
+    struct BvhHit {
+        float t, u, v;    // position = (1 - u - v) * p0 + u * p1 + v * p2
+        int32_t triangle; // Mesh triangle index, -1 : miss
+    };
+
+    // Function table of the ISA specific kernels.
+    // Vertices are Vector3 layout (x, y, z, pad), matrices are row-major float[16].
+    struct KernelTable {
+        SimdLevel level;
+
+        // out[i] = (in[i].xyz, 1) * mat  (xyzw result)
+        void (*TransformPoints)(const float* in, float* out, size_t count, const float* mat);
+
+        // MVP transform + perspective divide + viewport, 1 / w in the pad lane (same as Rasterizer::TransformVertex)
+        void (*ProjectVertices)(const float* in, float* out, size_t count, const float* mvp, int width, int height);
+
+        // Triangle setup, 8 triangles per step : cull zero area, back facing, off-target & sub-pixel
+        // triangles, write the records of the others in input order (triangles : 3 vertex indices each)
+        // counts (nullable) are accumulated. Return : the number of records written (<= count)
+        size_t (*SetupTriangles)(const float* screen, const int32_t* triangles, size_t count, int width, int height,
+                                 TriangleSetup* out, TriangleSetupCounts* counts);
+
+        // Edge test + depth test of one span, writes depth and rgb of the passing pixels
+        // stats may be nullptr
+        // Return : the number of pixels written
+        int (*RasterRow)(const RasterRowSetup& setup, int count, float* depthRow, float* rgbRow, const float* color, RasterRowStats* stats);
+
+        // RasterRow with a texture lookup per pixel (mip level from the uv derivatives), color = texel * tint
+        int (*RasterRowTextured)(const RasterRowSetup& setup, const TexturedRowSetup& uv, const TextureView& texture,
+                                 int count, float* depthRow, float* rgbRow, const float* tint, RasterRowStats* stats);
+
+        // Filtered texture lookups : rgb[3 * i] = texture(u[i], v[i]) at mip level lod[i]
+        void (*SampleTexture)(const TextureView& texture, const float* u, const float* v, const float* lod, float* rgbOut, size_t count);
+
+        // float rgb [0, 1] -> 8-bit rgb (clamp, * 255.99, truncate)
+        void (*ConvertRGB8)(const float* in, uint8_t* out, size_t count);
+
+        // --- Compact vertex decode (PackedVertex.h) -> Vector3 layout (x, y, z, 0) ---
+        void (*DecodeFloat3)(const float* in, float* out, size_t count);       // PackedFloat3
+        void (*DecodeHalf3)(const uint16_t* in, float* out, size_t count);     // Half3
+        void (*DecodeNormals)(const uint32_t* in, float* out, size_t count);   // PackedNormal
+
+        // half array -> float array (Half2 uvs : count = 2 * vertices)
+        void (*DecodeHalf)(const uint16_t* in, float* out, size_t count);
+
+        // --- Batch math (accuracy : SimdMath.h) ---
+        void (*SinCos)(const float* x, float* sinOut, float* cosOut, size_t count);
+        void (*Tan)(const float* x, float* out, size_t count);
+        void (*Atan2)(const float* y, const float* x, float* out, size_t count);
+        void (*Acos)(const float* x, float* out, size_t count);
+        void (*Exp)(const float* x, float* out, size_t count);
+        void (*Rsqrt)(const float* x, float* out, size_t count);
+
+        // --- BVH queries (Bvh.h) ---
+        // Closest hit of each ray (double sided)
+        void (*IntersectRays)(const BvhView& bvh, const BvhRay* rays, BvhHit* hits, size_t count);
+        // Any hit of each ray (1 : occluded, 0 : visible)
+        void (*OccludedRays)(const BvhView& bvh, const BvhRay* rays, uint8_t* occluded, size_t count);
+    };
+
+    // --- CPU Feature Detection ---
+    // Highest level supported by the CPU & OS (CPUID + XGETBV)
+    SimdLevel DetectSimdLevel();
+
+    // Level selected at startup.
+    // Environment override : SHIKA_SIMD=sse41|avx2|avx512 (clamped to the detected level)
+    SimdLevel GetSimdLevel();
+
+    const char* SimdLevelName(SimdLevel level);
+
+    // Kernel table of the selected level
+    const KernelTable& GetKernels();
+
+    // Kernel table of a specific level (for tests/benchmarks, must be supported by the CPU)
+    const KernelTable& GetKernels(SimdLevel level);
+}
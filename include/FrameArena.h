@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Shika {
+
+    // Bump allocator for transient (per-frame) data.
+    // Allocate : pointer bump, Deallocate : no-op, Reset : O(1).
+    // When a frame overflows the block, a new block is chained and the arena is
+    // coalesced into one block of the total size on Reset, so steady-state frames never malloc.
+    class alignas(64) LinearArena {
+        public:
+           explicit LinearArena(size_t initialCapacity = 1 << 20);
+           ~LinearArena();
+
+           LinearArena(const LinearArena&) = delete;
+           LinearArena& operator=(const LinearArena&) = delete;
+
+           // Raw memory (align : power of two, up to BlockAlignment)
+           void* Allocate(size_t size, size_t align = alignof(std::max_align_t)) {
+               uintptr_t p = ((uintptr_t)cursor + (align - 1)) & ~(uintptr_t)(align - 1);
+               if (p + size > (uintptr_t)end) return AllocateSlow(size, align);
+               cursor = (char*)(p + size);
+               return (void*)p;
+           }
+
+           // Uninitialized array, T must be trivially destructible (never destroyed)
+           template <typename T>
+           T* AllocateArray(size_t count) {
+               return static_cast<T*>(Allocate(count * sizeof(T), alignof(T)));
+           }
+
+           // Release everything allocated since the last Reset
+           void Reset();
+
+           size_t Used() const;
+           size_t Capacity() const { return capacity; }
+           // Number of heap blocks requested so far (stays constant in steady state)
+           size_t BlockAllocations() const { return blockAllocations; }
+
+           static constexpr size_t BlockAlignment = 64;
+
+        private:
+           struct Block {
+               Block* prev;
+               size_t size;
+               // data follows (BlockAlignment)
+           };
+
+           void* AllocateSlow(size_t size, size_t align);
+           void PushBlock(size_t size);
+           static char* BlockData(Block* block) { return reinterpret_cast<char*>(block) + BlockAlignment; }
+
+           Block* current = nullptr; // newest block, older ones are linked by prev
+           char* cursor = nullptr;
+           char* end = nullptr;
+           size_t capacity = 0;      // sum of every block size
+           size_t retired = 0;       // used bytes of the older blocks
+           size_t blockAllocations = 0;
+    };
+
+    // Frame scoped arena with one sub-arena per worker thread (no locking, no false sharing)
+    class FrameArena {
+        public:
+           explicit FrameArena(int threadCount = 1, size_t capacityPerThread = 1 << 20) {
+               threads.reserve(threadCount);
+               for (int i = 0; i < threadCount; i++) {
+                   threads.emplace_back(new LinearArena(capacityPerThread));
+               }
+           }
+
+           // Sub-arena of a worker (index : [0, ThreadCount()))
+           LinearArena& Thread(int index) { return *threads[index]; }
+
+           int ThreadCount() const { return (int)threads.size(); }
+
+           // Frame end : release every transient buffer
+           void Reset() {
+               for (auto& arena : threads) arena->Reset();
+           }
+
+        private:
+           std::vector<std::unique_ptr<LinearArena>> threads;
+    };
+
+    // STL compatible allocator on top of a LinearArena (deallocate is a no-op)
+    template <typename T>
+    struct ArenaAllocator {
+        using value_type = T;
+
+        LinearArena* arena;
+
+        ArenaAllocator(LinearArena& a) : arena(&a) {}
+        template <typename U>
+        ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+        T* allocate(size_t n) { return static_cast<T*>(arena->Allocate(n * sizeof(T), alignof(T))); }
+        void deallocate(T*, size_t) {}
+
+        template <typename U>
+        bool operator==(const ArenaAllocator<U>& other) const { return arena == other.arena; }
+        template <typename U>
+        bool operator!=(const ArenaAllocator<U>& other) const { return arena != other.arena; }
+    };
+
+    template <typename T>
+    using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+}
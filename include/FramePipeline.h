@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include "../include/Canvas.h"
+
+namespace Shika {
+
+    // --- Frame Sinks ---
+    // Destination of the 8-bit RGB frames (called from the pipeline's encoder thread only)
+    class FrameSink {
+        public:
+           virtual ~FrameSink() = default;
+
+           // rgb : width * height * 3 bytes, row-major. Return false on a write error
+           virtual bool WriteFrame(const uint8_t* rgb, int width, int height) = 0;
+
+           // End of the sequence (flush / close)
+           virtual bool Finish() { return true; }
+    };
+
+    // One binary PPM (P6) per frame, file name from a printf pattern with the frame index ("frame_%04d.ppm")
+    class PpmSequenceSink : public FrameSink {
+        public:
+           explicit PpmSequenceSink(std::string pattern) : pattern(std::move(pattern)) {}
+
+           bool WriteFrame(const uint8_t* rgb, int width, int height) override;
+
+        private:
+           std::string pattern;
+           int frameIndex = 0;
+    };
+
+    // Stream sinks write to a file ("-" : stdout) or to an already open FILE* (e.g. a popen'd encoder)
+    class StreamSink : public FrameSink {
+        public:
+           explicit StreamSink(const std::string& path);
+           explicit StreamSink(std::FILE* stream) : file(stream), owned(false) {}
+           ~StreamSink() override;
+
+           StreamSink(const StreamSink&) = delete;
+           StreamSink& operator=(const StreamSink&) = delete;
+
+           bool IsOpen() const { return file != nullptr; }
+           bool Finish() override;
+
+        protected:
+           bool Write(const void* data, size_t size);
+
+           std::FILE* file = nullptr;
+           bool owned = false;
+    };
+
+    // Headerless rgb24 frames (ffmpeg -f rawvideo -pix_fmt rgb24 -video_size WxH -i ...)
+    class RawVideoSink : public StreamSink {
+        public:
+           using StreamSink::StreamSink;
+
+           bool WriteFrame(const uint8_t* rgb, int width, int height) override;
+    };
+
+    enum class Y4mChroma {
+        C420, // 4:2:0, 2x2 averaged chroma (C420jpeg, the most widely supported)
+        C444  // full resolution chroma
+    };
+
+    // YUV4MPEG2 stream, BT.601 limited range. The header is written with the first frame
+    class Y4mSink : public StreamSink {
+        public:
+           explicit Y4mSink(const std::string& path, int fpsNumerator = 30, int fpsDenominator = 1, Y4mChroma chroma = Y4mChroma::C420)
+               : StreamSink(path), fpsNum(fpsNumerator), fpsDen(fpsDenominator), chroma(chroma) {}
+           explicit Y4mSink(std::FILE* stream, int fpsNumerator = 30, int fpsDenominator = 1, Y4mChroma chroma = Y4mChroma::C420)
+               : StreamSink(stream), fpsNum(fpsNumerator), fpsDen(fpsDenominator), chroma(chroma) {}
+
+           bool WriteFrame(const uint8_t* rgb, int width, int height) override;
+
+        private:
+           int fpsNum, fpsDen;
+           Y4mChroma chroma;
+           int streamWidth = 0, streamHeight = 0; // 0 : header not written yet
+           std::vector<uint8_t> planes;
+    };
+
+    // --- Frame Pipeline ---
+    // Ring of Canvas targets : frame N + 1 renders on the calling thread while frame N is
+    // converted to RGB8 & written by the sink on a background encoder thread.
+    // The ring is the bounded queue : BeginFrame blocks while every canvas is still queued (backpressure).
+    // A canvas returns to the ring as soon as it is converted, before the sink write.
+    // The sink must outlive the pipeline.
+    class FramePipeline {
+        public:
+           // ringSize >= 2 (2 : double buffering, more absorbs write latency spikes)
+           FramePipeline(int width, int height, FrameSink& sink, int ringSize = 3);
+           ~FramePipeline(); // Finish
+
+           FramePipeline(const FramePipeline&) = delete;
+           FramePipeline& operator=(const FramePipeline&) = delete;
+
+           // Next free canvas, cleared to color with a cleared depth buffer
+           Canvas& BeginFrame(const Color& clearColor = Color::Black());
+
+           // Queue the canvas of BeginFrame for encoding
+           void EndFrame();
+
+           // Drain the queue, stop the encoder thread & finish the sink (frames ended afterwards are dropped)
+           // Return : false if any write failed (the following frames are dropped)
+           bool Finish();
+
+           int RingSize() const { return (int)canvases.size(); }
+           size_t FramesSubmitted() const { return submitted; }
+           size_t FramesWritten() const;
+           // Times BeginFrame had to wait for the encoder
+           size_t Stalls() const;
+
+        private:
+           void EncoderLoop();
+
+           FrameSink& sink;
+           std::vector<std::unique_ptr<Canvas>> canvases;
+
+           mutable std::mutex mutex;
+           std::condition_variable freeCondition;  // a canvas came back to the ring
+           std::condition_variable readyCondition; // a frame was queued, or stopping
+           std::deque<int> freeCanvases;
+           std::deque<int> readyCanvases;
+           bool stopping = false;
+           bool failed = false;
+           size_t written = 0;
+           size_t stalls = 0;
+
+           int current = -1; // canvas between BeginFrame & EndFrame
+           size_t submitted = 0;
+           std::thread encoder;
+    };
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstddef>
 #include "Vector3.h"
 
 namespace Shika {
@@ -42,14 +43,12 @@ namespace Shika {
             __m128 x = _mm_set1_ps(v.x); // [x, x, x, x]
             __m128 y = _mm_set1_ps(v.y); // [y, y, y, y]
             __m128 z = _mm_set1_ps(v.z); // [z, z, z, z]
-            __m128 w = _mm_set1_ps(1.0f); // [1, 1, 1, 1]
 
             // Linear Combination
             // Result = x*Row0 + y*Row1 + z*Row2 + 1*Row3
-            __m128 r = _mm_mul_ps(x, mat.row[0]);
-            r = _mm_add_ps(r, _mm_mul_ps(y, mat.row[1]));
-            r = _mm_add_ps(r, _mm_mul_ps(z, mat.row[2]));
-            r = _mm_add_ps(r, _mm_mul_ps(w, mat.row[3])); 
+            __m128 r = MulAdd(x, mat.row[0], mat.row[3]);
+            r = MulAdd(y, mat.row[1], r);
+            r = MulAdd(z, mat.row[2], r);
 
             return Vector3(r);
         }
@@ -58,12 +57,10 @@ namespace Shika {
             __m128 x = _mm_set1_ps(v.x);
             __m128 y = _mm_set1_ps(v.y);
             __m128 z = _mm_set1_ps(v.z);
-            __m128 w = _mm_set1_ps(1.0f);
 
-            __m128 r = _mm_mul_ps(x, mat.row[0]);
-            r = _mm_add_ps(r, _mm_mul_ps(y, mat.row[1]));
-            r = _mm_add_ps(r, _mm_mul_ps(z, mat.row[2]));
-            r = _mm_add_ps(r, _mm_mul_ps(w, mat.row[3]));
+            __m128 r = MulAdd(x, mat.row[0], mat.row[3]);
+            r = MulAdd(y, mat.row[1], r);
+            r = MulAdd(z, mat.row[2], r);
 
             return r;
         }
@@ -75,8 +72,8 @@ namespace Shika {
            // w = 0
     
            __m128 r = _mm_mul_ps(x, mat.row[0]);
-           r = _mm_add_ps(r, _mm_mul_ps(y, mat.row[1]));
-           r = _mm_add_ps(r, _mm_mul_ps(z, mat.row[2]));
+           r = MulAdd(y, mat.row[1], r);
+           r = MulAdd(z, mat.row[2], r);
            // Not add row[3] (Translation)
     
            return r;
@@ -119,9 +116,9 @@ namespace Shika {
             __m128 w = _mm_shuffle_ps(rowVec, rowVec, _MM_SHUFFLE(3, 3, 3, 3));
             
             __m128 r = _mm_mul_ps(x, other.row[0]);
-            r = _mm_add_ps(r, _mm_mul_ps(y, other.row[1]));
-            r = _mm_add_ps(r, _mm_mul_ps(z, other.row[2]));
-            r = _mm_add_ps(r, _mm_mul_ps(w, other.row[3]));
+            r = MulAdd(y, other.row[1], r);
+            r = MulAdd(z, other.row[2], r);
+            r = MulAdd(w, other.row[3], r);
 
             return r;
           }
@@ -155,37 +152,47 @@ namespace Shika {
           }
           // Rotations around x-axis
           static Matrix4x4 RotationX(float angleInRadian) {
+            return RotationXFromSinCos(std::sin(angleInRadian), std::cos(angleInRadian));
+          }
+          // Rotations around y-axis
+          static Matrix4x4 RotationY(float angleInRadian) {
+            return RotationYFromSinCos(std::sin(angleInRadian), std::cos(angleInRadian));
+          }
+          // Rotations around z-axis
+          static Matrix4x4 RotationZ(float angleInRadian) {
+            return RotationZFromSinCos(std::sin(angleInRadian), std::cos(angleInRadian));
+          }
+
+          static Matrix4x4 RotationXFromSinCos(float s, float c) {
             Matrix4x4 mat;
-            float c = std::cos(angleInRadian);
-            float s = std::sin(angleInRadian);
             mat.row[0] = _mm_set_ps(0, 0, 0, 1);
             mat.row[1] = _mm_set_ps(0, -s, c, 0);
             mat.row[2] = _mm_set_ps(0, c, s, 0);
             mat.row[3] = _mm_set_ps(1, 0, 0, 0);
             return mat;
           }
-          // Rotations around y-axis
-          static Matrix4x4 RotationY(float angleInRadian) {
+          static Matrix4x4 RotationYFromSinCos(float s, float c) {
             Matrix4x4 mat;
-            float c = std::cos(angleInRadian);
-            float s = std::sin(angleInRadian);
             mat.row[0] = _mm_set_ps(0, s, 0, c);
             mat.row[1] = _mm_set_ps(0, 0, 1, 0);
             mat.row[2] = _mm_set_ps(0, c, 0, -s);
             mat.row[3] = _mm_set_ps(1, 0, 0, 0);
             return mat;
           }
-          // Rotations around z-axis
-          static Matrix4x4 RotationZ(float angleInRadian) {
+          static Matrix4x4 RotationZFromSinCos(float s, float c) {
             Matrix4x4 mat;
-            float c = std::cos(angleInRadian);
-            float s = std::sin(angleInRadian);
             mat.row[0] = _mm_set_ps(0, 0, -s, c);
             mat.row[1] = _mm_set_ps(0, 0, c, s);
             mat.row[2] = _mm_set_ps(0, 1, 0, 0);
             mat.row[3] = _mm_set_ps(1, 0, 0, 0);
             return mat;
           }
+
+          // --- Batch Rotations (SimdMath::SinCos, src/SimdMath.cpp) ---
+          // out[i] = RotationX(angles[i]) within the SinCos error bound
+          static void RotationXBatch(const float* angles, Matrix4x4* out, size_t count);
+          static void RotationYBatch(const float* angles, Matrix4x4* out, size_t count);
+          static void RotationZBatch(const float* angles, Matrix4x4* out, size_t count);
         
        public :
           // --- View&Projection ---
@@ -1,12 +1,98 @@
 #pragma once
 
 #include <vector>
+#include <array>
+#include <algorithm>
 #include "../include/Vector3.h"
+#include "../include/PackedVertex.h"
+#include "../include/CpuDispatch.h"
 
 namespace Shika {
+
+    // Storage format of Mesh positions
+    enum class VertexFormat {
+        Float3Aligned, // Vector3 (16 bytes)
+        Float3Packed,  // PackedFloat3 (12 bytes)
+        Half3          // Half3 (6 bytes)
+    };
+
     struct Mesh {
         std::vector<Vector3> vertices;
-        std::vector<std::vector<int>> indices; 
+        std::vector<std::array<int, 3>> indices; // Triangle list (contiguous, no per-triangle allocation)
+
+        // --- Compact Storage ---
+        // Positions live in the stream selected by positionFormat
+        VertexFormat positionFormat = VertexFormat::Float3Aligned;
+        std::vector<PackedFloat3> packedVertices;
+        std::vector<Half3> halfVertices;
+
+        // Optional per-vertex attributes
+        std::vector<PackedNormal> normals;
+        std::vector<Half2> uvs;
+
+        size_t VertexCount() const {
+            switch (positionFormat) {
+                case VertexFormat::Float3Packed: return packedVertices.size();
+                case VertexFormat::Half3:        return halfVertices.size();
+                default:                         return vertices.size();
+            }
+        }
+
+        // Batch decode positions [first, first + count) into Vector3 layout
+        void DecodePositions(size_t first, size_t count, Vector3* out) const {
+            if (count == 0) return;
+            const KernelTable& k = GetKernels();
+            float* dst = reinterpret_cast<float*>(out);
+            switch (positionFormat) {
+                case VertexFormat::Float3Packed:
+                    k.DecodeFloat3(&packedVertices[first].x, dst, count);
+                    break;
+                case VertexFormat::Half3:
+                    k.DecodeHalf3(&halfVertices[first].x, dst, count);
+                    break;
+                default:
+                    std::copy(vertices.begin() + first, vertices.begin() + first + count, out);
+                    break;
+            }
+        }
+
+        // Batch decode normals [first, first + count)
+        void DecodeNormals(size_t first, size_t count, Vector3* out) const {
+            if (count == 0) return;
+            GetKernels().DecodeNormals(&normals[first].bits, reinterpret_cast<float*>(out), count);
+        }
+
+        // Batch decode uvs [first, first + count) into (u, v) float pairs
+        void DecodeUVs(size_t first, size_t count, float* out) const {
+            if (count == 0) return;
+            GetKernels().DecodeHalf(&uvs[first].u, out, 2 * count);
+        }
+
+        // Move the positions into another storage format (Half3 is lossy)
+        void SetPositionFormat(VertexFormat format) {
+            if (format == positionFormat) return;
+
+            std::vector<Vector3> decoded(VertexCount());
+            DecodePositions(0, decoded.size(), decoded.data());
+
+            vertices.clear(); packedVertices.clear(); halfVertices.clear();
+            vertices.shrink_to_fit(); packedVertices.shrink_to_fit(); halfVertices.shrink_to_fit();
+
+            switch (format) {
+                case VertexFormat::Float3Packed:
+                    packedVertices.reserve(decoded.size());
+                    for (const auto& v : decoded) packedVertices.push_back(PackFloat3(v));
+                    break;
+                case VertexFormat::Half3:
+                    halfVertices.reserve(decoded.size());
+                    for (const auto& v : decoded) halfVertices.push_back(PackHalf3(v));
+                    break;
+                default:
+                    vertices = std::move(decoded);
+                    break;
+            }
+            positionFormat = format;
+        }
 
         static Mesh CreateCube() {
             Mesh mesh;
@@ -22,4 +108,4 @@ namespace Shika {
             return mesh;
         }
     };
-}
\ No newline at end of file
+}
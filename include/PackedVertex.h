@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include "Vector3.h"
+
+namespace Shika {
+
+    // --- Compact Vertex Storage ---
+    // Vector3 is 16 bytes (SIMD padded), these are the storage formats for large meshes.
+    // Batch decode into Vector3 layout : KernelTable::Decode* (CpuDispatch.h)
+
+    // Tightly packed float3 (12 bytes)
+    struct PackedFloat3 {
+        float x, y, z;
+    };
+
+    // IEEE half precision float3 (6 bytes), max relative error 2^-11
+    // (the F16C decode path quiets signaling NaNs)
+    struct Half3 {
+        uint16_t x, y, z;
+    };
+
+    // IEEE half precision float2 (4 bytes) for texture coordinates
+    struct Half2 {
+        uint16_t u, v;
+    };
+
+    // Unit vector as snorm 10:10:10:2 (4 bytes), max error 1/1022 per component
+    struct PackedNormal {
+        uint32_t bits;
+    };
+
+    static_assert(sizeof(PackedFloat3) == 12, "PackedFloat3 must be tightly packed");
+    static_assert(sizeof(Half3) == 6, "Half3 must be tightly packed");
+    static_assert(sizeof(Half2) == 4, "Half2 must be tightly packed");
+    static_assert(sizeof(PackedNormal) == 4, "PackedNormal must be tightly packed");
+
+    // --- Scalar Conversion Helpers ---
+    // float -> half (round to nearest even, overflow -> inf, NaN preserved)
+    inline uint16_t FloatToHalf(float value) {
+        uint32_t f;
+        std::memcpy(&f, &value, 4);
+        uint32_t sign = f & 0x80000000u;
+        f ^= sign;
+
+        uint32_t o;
+        if (f >= 0x47800000u) {
+            // Inf or NaN (all exponent bits set), or too large
+            o = (f > 0x7F800000u) ? 0x7E00u : 0x7C00u;
+        }
+        else if (f < 0x38800000u) {
+            // Subnormal or zero : let the FPU do the rounding
+            const uint32_t denormMagicBits = ((127 - 15) + (23 - 10) + 1) << 23;
+            float denormMagic, tmp;
+            std::memcpy(&denormMagic, &denormMagicBits, 4);
+            std::memcpy(&tmp, &f, 4);
+            tmp += denormMagic;
+            std::memcpy(&f, &tmp, 4);
+            o = f - denormMagicBits;
+        }
+        else {
+            uint32_t mantOdd = (f >> 13) & 1;
+            f += ((uint32_t)(15 - 127) << 23) + 0xFFFu;
+            f += mantOdd;
+            o = f >> 13;
+        }
+        return (uint16_t)(o | (sign >> 16));
+    }
+
+    // half -> float (exact)
+    inline float HalfToFloat(uint16_t h) {
+        const uint32_t shiftedExp = 0x7C00u << 13;
+        uint32_t o = ((uint32_t)h & 0x7FFFu) << 13;
+        uint32_t exp = shiftedExp & o;
+        o += (uint32_t)(127 - 15) << 23;
+
+        if (exp == shiftedExp) {
+            // Inf / NaN
+            o += (uint32_t)(128 - 16) << 23;
+        }
+        else if (exp == 0) {
+            // Zero / Subnormal : renormalize
+            const uint32_t magicBits = 113u << 23;
+            float magic, tmp;
+            std::memcpy(&magic, &magicBits, 4);
+            o += 1u << 23;
+            std::memcpy(&tmp, &o, 4);
+            tmp -= magic;
+            std::memcpy(&o, &tmp, 4);
+        }
+        o |= ((uint32_t)h & 0x8000u) << 16;
+
+        float result;
+        std::memcpy(&result, &o, 4);
+        return result;
+    }
+
+    inline PackedFloat3 PackFloat3(const Vector3& v) {
+        return { v.x, v.y, v.z };
+    }
+
+    inline Half3 PackHalf3(const Vector3& v) {
+        return { FloatToHalf(v.x), FloatToHalf(v.y), FloatToHalf(v.z) };
+    }
+
+    inline Half2 PackHalf2(float u, float v) {
+        return { FloatToHalf(u), FloatToHalf(v) };
+    }
+
+    // Components are clamped to [-1, 1]
+    inline PackedNormal PackNormal(const Vector3& n) {
+        auto quantize = [](float c) -> uint32_t {
+            c = c < -1.0f ? -1.0f : (c > 1.0f ? 1.0f : c);
+            int q = (int)std::lround(c * 511.0f);
+            return (uint32_t)q & 0x3FFu;
+        };
+        return { quantize(n.x) | (quantize(n.y) << 10) | (quantize(n.z) << 20) };
+    }
+
+    inline Vector3 UnpackFloat3(const PackedFloat3& p) {
+        return Vector3(p.x, p.y, p.z);
+    }
+
+    inline Vector3 UnpackHalf3(const Half3& h) {
+        return Vector3(HalfToFloat(h.x), HalfToFloat(h.y), HalfToFloat(h.z));
+    }
+
+    inline Vector3 UnpackNormal(const PackedNormal& n) {
+        auto dequantize = [](uint32_t bits) -> float {
+            int q = (int)(bits << 22) >> 22; // sign extend 10 bits
+            float c = (float)q * (1.0f / 511.0f);
+            return c < -1.0f ? -1.0f : c;
+        };
+        return Vector3(dequantize(n.bits), dequantize(n.bits >> 10), dequantize(n.bits >> 20));
+    }
+}
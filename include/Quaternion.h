@@ -20,13 +20,25 @@ namespace Shika {
 
         // 3. With Axis-Angle
         static Quaternion RotationAxis(Vector3 axis, float angleRadian) {
-            Vector3 n = axis.Normalized();
-            float sinHalf = std::sin(angleRadian * 0.5f);
-            float cosHalf = std::cos(angleRadian * 0.5f);
+            return RotationAxisFromSinCos(axis, std::sin(angleRadian * 0.5f), std::cos(angleRadian * 0.5f));
+        }
 
+        // sinHalf / cosHalf : sin & cos of the half angle
+        static Quaternion RotationAxisFromSinCos(Vector3 axis, float sinHalf, float cosHalf) {
+            Vector3 n = axis.Normalized();
             return Quaternion(n.x * sinHalf, n.y * sinHalf, n.z * sinHalf, cosHalf);
         }
 
+        // 4. With Euler Angles (roll around Z, then pitch around X, then yaw around Y)
+        static Quaternion RotationYawPitchRoll(float pitch, float yaw, float roll) {
+            return RotationAxis(Vector3(0, 1, 0), yaw) * RotationAxis(Vector3(1, 0, 0), pitch) * RotationAxis(Vector3(0, 0, 1), roll);
+        }
+
+        // --- Batch Constructors (SimdMath::SinCos, src/SimdMath.cpp) ---
+        // Same results as the scalar versions within the SinCos error bound
+        static void RotationAxisBatch(const Vector3* axes, const float* angles, Quaternion* out, size_t count);
+        static void RotationYawPitchRollBatch(const float* pitch, const float* yaw, const float* roll, Quaternion* out, size_t count);
+
         public : 
         // Quaternion Multiplication
         Quaternion operator* (Quaternion other) const {
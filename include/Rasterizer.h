@@ -4,6 +4,11 @@
 #include "../include/Canvas.h"
 #include "../include/Vector3.h"
 #include "../include/Matrix4x4.h"
+#include "../include/CpuDispatch.h"
+#include "../include/RenderStats.h"
+#include "../include/FrameArena.h"
+#include "../include/Mesh.h"
+#include "../include/Texture.h"
 
 namespace Shika{
 
@@ -13,12 +18,39 @@ namespace Shika{
     public:
         // --- Draw Functions ---
         static void DrawFilledTriangle(Canvas& canvas, const Vector3& v0, const Vector3& v1, const Vector3& v2, Color color);
+        // Textured fill : perspective correct uv (1 / w from TransformVertex), mip level per pixel, color = texel * tint
+        static void DrawFilledTriangle(Canvas& canvas, const Vector3& v0, const Vector3& v1, const Vector3& v2,
+                                       TexCoord t0, TexCoord t1, TexCoord t2, const Texture& texture, Color tint = Color::White());
+        // Triangle list sharing one state (indices into screen / uvs), textured if texture and uvs are set
+        // Setup stage + raster in chunks
+        static void DrawTriangles(Canvas& canvas, const Vector3* screen, const TexCoord* uvs,
+                                  const std::array<int, 3>* triangles, size_t count, const Texture* texture, Color color);
+
+        // --- Triangle Setup Stage ---
+        // Cull zero area, back facing, off-canvas & sub-pixel triangles, 8 per step (SIMD kernel of the selected ISA).
+        // screen : TransformVertex / ProjectMesh output. Records of the visible triangles in input order.
+        // Return : the number of records written to out (at most count)
+        static size_t SetupTriangles(const Canvas& canvas, const Vector3* screen, const std::array<int, 3>* triangles,
+                                     size_t count, TriangleSetup* out);
+        // Rasterize setup records (textured : uvs of triangles[setup.triangle])
+        static void DrawTriangles(Canvas& canvas, const TriangleSetup* setups, size_t count, Color color);
+        static void DrawTriangles(Canvas& canvas, const TriangleSetup* setups, size_t count, const TexCoord* uvs,
+                                  const std::array<int, 3>* triangles, const Texture& texture, Color tint);
+
         static void DrawLine(Canvas& canvas, Point2D p1, Point2D p2, Color color);
+        // Transform & draw every triangle of the mesh, transient vertex buffers come from the arena
+        static void DrawMesh(Canvas& canvas, const Mesh& mesh, const Matrix4x4& mvpMatrix, Color color, LinearArena& arena);
+        // Textured version (mesh.uvs, flat tint if the mesh has none)
+        static void DrawMesh(Canvas& canvas, const Mesh& mesh, const Matrix4x4& mvpMatrix, const Texture& texture, Color tint, LinearArena& arena);
         
         
         // --- Utils ---
         static Vector3 CalculateFaceNormal(const Vector3& v0, const Vector3& v1, const Vector3& v2);
-        // 3D World Coordinate -> Screen Coordinate & Depth (Return Vector3 (x: screenX, y: screenY, z: depth))
+        // 3D World Coordinate -> Screen Coordinate & Depth (Return Vector3 (x: screenX, y: screenY, z: depth, e[3]: 1 / w))
         static Vector3 TransformVertex(const Vector3& vertex, const Matrix4x4& mvpMatrix, int width, int height);
+        // Batch version of TransformVertex (SIMD kernel of the selected ISA)
+        static void TransformVertices(const Vector3* vertices, Vector3* out, size_t count, const Matrix4x4& mvpMatrix, int width, int height);
+        // Screen space vertices of the mesh in any position format (released with the arena at frame end)
+        static Vector3* ProjectMesh(const Canvas& canvas, const Mesh& mesh, const Matrix4x4& mvpMatrix, LinearArena& arena);
     };
 }
\ No newline at end of file
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#else
+    #include <x86intrin.h>
+#endif
+
+namespace Shika {
+
+    class Canvas;
+
+    // Pipeline stages with their own cycle timer
+    enum class RenderStage : int {
+        Transform = 0, // vertex transform & projection
+        Setup,         // culling & bounding box
+        Raster,        // edge/depth test & pixel writes
+        Resolve,       // framebuffer conversion
+        Count
+    };
+
+    // Counters of one frame (one thread, or the sum over all threads after EndFrame)
+    struct RenderStats {
+        uint64_t verticesTransformed = 0;
+
+        uint64_t trianglesSubmitted = 0;
+        uint64_t trianglesCulledBackface = 0;
+        uint64_t trianglesCulledFrustum = 0;  // bounding box outside the canvas
+        uint64_t trianglesCulledZeroArea = 0;
+        uint64_t trianglesCulledSubPixel = 0; // no pixel centre inside the bounding box
+        uint64_t trianglesRasterized = 0;
+
+        uint64_t pixelsTested = 0;   // inside the bounding box
+        uint64_t pixelsCovered = 0;  // passed the edge test
+        uint64_t depthPass = 0;      // written
+        uint64_t depthFail = 0;
+
+        // Overdraw (only with an overdraw target, see Stats::EnableOverdraw)
+        uint64_t pixelsTouched = 0;  // pixels written at least once
+        float overdraw = 0.0f;       // depthPass / pixelsTouched
+
+        uint64_t stageCycles[(int)RenderStage::Count] = {};
+
+        RenderStats& operator+=(const RenderStats& other);
+
+        std::string ToJson() const;
+    };
+
+    namespace Stats {
+        // Counters of the calling thread (registered on first use)
+        RenderStats& Local();
+
+        // Reset the counters of every thread & the overdraw target
+        void BeginFrame();
+
+        // Sum of every thread's counters since BeginFrame
+        // Call while no thread is rendering
+        RenderStats EndFrame();
+
+        // Per-pixel write counters for a canvas of this size (0, 0 disables)
+        // Each rendering thread counts into its own buffer, EndFrame sums them
+        // Call while no thread is rendering
+        void EnableOverdraw(int width, int height);
+
+        // Row of the calling thread's overdraw counters, nullptr if disabled or the size does not match
+        uint16_t* OverdrawRow(int width, int height, int y);
+
+        // Heatmap of the overdraw summed by the last EndFrame (black: 0, blue: 1, green: 2, yellow: 3, red: 4+)
+        void RenderOverdrawHeatmap(Canvas& canvas);
+
+        inline const char* StageName(RenderStage stage) {
+            switch (stage) {
+                case RenderStage::Transform: return "transform";
+                case RenderStage::Setup:     return "setup";
+                case RenderStage::Raster:    return "raster";
+                case RenderStage::Resolve:   return "resolve";
+                default:                     return "unknown";
+            }
+        }
+
+        // RDTSC timer, adds the elapsed cycles to the stage on destruction
+        class ScopedTimer {
+            public:
+               explicit ScopedTimer(RenderStage s) : stage(s), start(__rdtsc()) {}
+               ~ScopedTimer() { Local().stageCycles[(int)stage] += __rdtsc() - start; }
+
+               ScopedTimer(const ScopedTimer&) = delete;
+               ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+            private:
+               RenderStage stage;
+               uint64_t start;
+        };
+    }
+}
+
+// --- Instrumentation Hooks ---
+// Compiled out unless the library is configured with -DSHIKA_ENABLE_STATS=ON
+#define SHIKA_STATS_CONCAT_(a, b) a##b
+#define SHIKA_STATS_CONCAT(a, b) SHIKA_STATS_CONCAT_(a, b)
+
+#if defined(SHIKA_ENABLE_STATS)
+    #define SHIKA_STATS_ADD(counter, n) (::Shika::Stats::Local().counter += (uint64_t)(n))
+    #define SHIKA_STATS_SCOPE(stage) ::Shika::Stats::ScopedTimer SHIKA_STATS_CONCAT(shikaStatsTimer, __LINE__)(stage)
+#else
+    #define SHIKA_STATS_ADD(counter, n) ((void)0)
+    #define SHIKA_STATS_SCOPE(stage) ((void)0)
+#endif
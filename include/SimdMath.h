@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include "CpuDispatch.h"
+
+namespace Shika {
+
+    // --- Batch SIMD Math ---
+    // Arrays in, arrays out. 4 / 8 / 16 lanes per step (SSE4.1 / AVX2 / AVX-512, see CpuDispatch.h).
+    // Max errors are measured against double precision libm on every ISA path.
+    namespace SimdMath {
+
+        // sin & cos, max 3 ULP for |x| < 6434 (Cody-Waite reduction, accuracy degrades beyond)
+        inline void SinCos(const float* x, float* sinOut, float* cosOut, size_t count) {
+            GetKernels().SinCos(x, sinOut, cosOut, count);
+        }
+
+        // tan, max 4 ULP for |x| < 6434
+        inline void Tan(const float* x, float* out, size_t count) {
+            GetKernels().Tan(x, out, count);
+        }
+
+        // atan2(y, x), max 4 ULP for finite inputs (atan2(0, 0) = 0, -0 x is treated as +0)
+        inline void Atan2(const float* y, const float* x, float* out, size_t count) {
+            GetKernels().Atan2(y, x, out, count);
+        }
+
+        // acos, max 2 ULP on [-1, 1], NaN outside
+        inline void Acos(const float* x, float* out, size_t count) {
+            GetKernels().Acos(x, out, count);
+        }
+
+        // exp, max 2 ULP for x <= 88.72 (inf above), denormal results down to x = -103.97
+        inline void Exp(const float* x, float* out, size_t count) {
+            GetKernels().Exp(x, out, count);
+        }
+
+        // 1 / sqrt(x), hardware estimate + one Newton-Raphson step
+        // max 3 ULP for positive normal x (2 ULP on AVX-512), rsqrt(0) = inf
+        inline void Rsqrt(const float* x, float* out, size_t count) {
+            GetKernels().Rsqrt(x, out, count);
+        }
+    }
+}
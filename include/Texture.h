@@ -0,0 +1,85 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include "../include/Canvas.h"
+#include "../include/CpuDispatch.h"
+
+namespace Shika {
+
+    // Texel storage order of every mip level
+    enum class TextureLayout {
+        RowMajor = 0,
+        Morton   = 1, // Z-order swizzle : 2D neighbours stay in the same cache lines at any rotation
+        Auto     = 2  // Morton for power of two sizes, RowMajor otherwise (resolved by the constructor)
+    };
+
+    enum class TextureFilter {
+        Nearest   = 0, // point sample of level 0
+        Bilinear  = 1, // bilinear on the nearest mip level
+        Trilinear = 2  // bilinear on the two nearest levels, blended
+    };
+
+    enum class TextureWrap {
+        Repeat = 0,
+        Clamp  = 1
+    };
+
+    struct TexCoord { float u, v; };
+
+    // --- Texture ---
+    // RGBA8 texels (4 bytes) with an optional mip chain, sampled by the SIMD kernels
+    // (KernelTable::SampleTexture / RasterRowTextured).
+    // Dimensions up to 32768.
+    class Texture {
+        public:
+           // Morton levels are padded to power of two sizes : an explicit Morton layout on a non power of two
+           // texture costs up to 4x the memory (37x21 : 64x32 texels). Auto only swizzles when nothing is padded
+           Texture(int width, int height, const std::vector<Color>& texels, TextureLayout layout = TextureLayout::Auto);
+
+           static Texture Checkerboard(int size, int checks, Color a, Color b, TextureLayout layout = TextureLayout::Auto);
+
+           // Box filtered chain down to 1x1 (replaces the existing one)
+           void GenerateMips();
+
+           void SetFilter(TextureFilter f) { filter = f; }
+           void SetWrap(TextureWrap w) { wrap = w; }
+
+           int GetWidth() const { return width; }
+           int GetHeight() const { return height; }
+           int LevelCount() const { return levelCount; }
+           TextureLayout Layout() const { return layout; }
+           TextureFilter Filter() const { return filter; }
+           TextureWrap Wrap() const { return wrap; }
+           size_t SizeInBytes() const { return texels.size() * sizeof(uint32_t); }
+
+           // Texel of a level (no wrapping, x/y must be inside the level)
+           Color Fetch(int level, int x, int y) const;
+
+           // Scalar reference of the sampling kernels (u, v in [0, 1] per repeat, lod : mip level)
+           Color Sample(float u, float v, float lod = 0.0f) const;
+
+           // Batch sampling (SIMD kernel of the selected ISA)
+           void Sample(const float* u, const float* v, const float* lod, Color* out, size_t count) const {
+               GetKernels().SampleTexture(View(), u, v, lod, reinterpret_cast<float*>(out), count);
+           }
+
+           TextureView View() const;
+
+        private:
+           // Lay out levels [0, count) with the given sizes and store level 0
+           void AllocateLevels(int count);
+           void StoreLevel(int level, const std::vector<Color>& colors);
+           uint32_t TexelIndex(int level, int x, int y) const;
+           Color SampleBilinear(int level, float u, float v) const;
+           int WrapCoord(float c, int size) const;
+
+           int width, height;
+           int levelCount = 1;
+           TextureLayout layout;
+           TextureFilter filter = TextureFilter::Trilinear;
+           TextureWrap wrap = TextureWrap::Repeat;
+           std::vector<uint32_t> texels;
+           int32_t offset[16], levelWidth[16], levelHeight[16], mortonMask[16];
+    };
+}
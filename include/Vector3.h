@@ -90,7 +90,7 @@ namespace Shika {
 
          // For Fast Normalize (Precision: ~0.03% error, No Zero Check)
          void NormalizeFast() {
-            __m128 dp = _mm_dp_ps(v, v, 0xFF);
+            __m128 dp = _mm_dp_ps(v, v, 0x7F); // x, y, z only (w may hold data, e.g. 1 / w of projected vertices)
 
             __m128 rsqrt = _mm_rsqrt_ps(dp);
 
@@ -0,0 +1,322 @@
+#include "../include/Bvh.h"
+#include "../include/FrameArena.h"
+#include <algorithm>
+#include <cassert>
+#include <thread>
+
+namespace Shika {
+
+    namespace {
+
+        const int BinCount = 16;
+        const int MaxLeafSize = 8;            // one BvhTriangles8 per leaf
+        const int MaxSahDepth = 64;           // deeper : object median splits (bounds the traversal stack)
+        // Median splits halve the range : 32 more levels reach MaxLeafSize from any uint32 count
+        static_assert(MaxSahDepth + 32 < BvhMaxDepth, "median tail can exceed BvhMaxDepth");
+        const uint32_t ParallelMinCount = 4096;
+        const float TraversalCost = 1.0f;     // one BVH8 node test ~ one leaf test
+
+        // SAH cost unit : one 8-wide leaf test (8 triangles cost the same as 1)
+        inline float LeafBlocks(uint32_t count) {
+            return (float)((count + MaxLeafSize - 1) / MaxLeafSize);
+        }
+
+        struct Aabb {
+            float mn[3], mx[3];
+
+            static Aabb Empty() {
+                const float inf = std::numeric_limits<float>::infinity();
+                return { { inf, inf, inf }, { -inf, -inf, -inf } };
+            }
+
+            void Grow(const float* p) {
+                for (int a = 0; a < 3; a++) {
+                    mn[a] = std::min(mn[a], p[a]);
+                    mx[a] = std::max(mx[a], p[a]);
+                }
+            }
+
+            void Grow(const Aabb& b) {
+                for (int a = 0; a < 3; a++) {
+                    mn[a] = std::min(mn[a], b.mn[a]);
+                    mx[a] = std::max(mx[a], b.mx[a]);
+                }
+            }
+
+            // Half surface area (the SAH only needs ratios), 0 for empty boxes
+            float Area() const {
+                float dx = mx[0] - mn[0], dy = mx[1] - mn[1], dz = mx[2] - mn[2];
+                if (dx < 0.0f || dy < 0.0f || dz < 0.0f) return 0.0f;
+                return dx * dy + dy * dz + dz * dx;
+            }
+        };
+
+        // Binary build tree (arena allocated, thrown away after the BVH8 collapse)
+        struct BuildNode {
+            Aabb box;
+            BuildNode* child[2]; // nullptr : leaf
+            uint32_t first, count;
+        };
+
+        struct BuildContext {
+            std::vector<Aabb> bounds;       // per triangle
+            std::vector<Vector3> centroids; // per triangle
+            std::vector<uint32_t> order;    // triangle indices, partitioned in place
+            FrameArena* arenas;
+        };
+
+        BuildNode* MakeLeaf(LinearArena& arena, const Aabb& box, uint32_t first, uint32_t count) {
+            BuildNode* node = arena.AllocateArray<BuildNode>(1);
+            node->box = box;
+            node->child[0] = node->child[1] = nullptr;
+            node->first = first;
+            node->count = count;
+            return node;
+        }
+
+        // Binned SAH over the 3 axes, partitions the range and returns the split position
+        // makeLeaf : the range should stay a leaf (nothing is partitioned)
+        uint32_t SplitSah(BuildContext& ctx, uint32_t first, uint32_t count, const Aabb& box, const Aabb& centroidBox, bool& makeLeaf) {
+            struct Bin { Aabb box; uint32_t count; };
+
+            float bestCost = std::numeric_limits<float>::infinity();
+            int bestAxis = -1, bestBin = 0;
+            float parentArea = box.Area();
+
+            for (int axis = 0; axis < 3; axis++) {
+                float lo = centroidBox.mn[axis], extent = centroidBox.mx[axis] - lo;
+                if (!(extent > 0.0f)) continue;
+                float scale = BinCount / extent;
+
+                Bin bins[BinCount];
+                for (auto& b : bins) { b.box = Aabb::Empty(); b.count = 0; }
+                for (uint32_t i = first; i < first + count; i++) {
+                    uint32_t tri = ctx.order[i];
+                    int b = std::min(BinCount - 1, (int)((ctx.centroids[tri].e[axis] - lo) * scale));
+                    bins[b].box.Grow(ctx.bounds[tri]);
+                    bins[b].count++;
+                }
+
+                // Sweep : right side areas, then left side + evaluate
+                float rightArea[BinCount];
+                uint32_t rightCount[BinCount];
+                Aabb acc = Aabb::Empty();
+                uint32_t n = 0;
+                for (int b = BinCount - 1; b > 0; b--) {
+                    acc.Grow(bins[b].box);
+                    n += bins[b].count;
+                    rightArea[b] = acc.Area();
+                    rightCount[b] = n;
+                }
+
+                acc = Aabb::Empty();
+                n = 0;
+                for (int b = 1; b < BinCount; b++) {
+                    acc.Grow(bins[b - 1].box);
+                    n += bins[b - 1].count;
+                    if (n == 0 || rightCount[b] == 0) continue;
+                    float cost = acc.Area() * LeafBlocks(n) + rightArea[b] * LeafBlocks(rightCount[b]);
+                    if (cost < bestCost) {
+                        bestCost = cost;
+                        bestAxis = axis;
+                        bestBin = b;
+                    }
+                }
+            }
+
+            if (bestAxis < 0) {
+                // Every centroid in the same place
+                makeLeaf = count <= (uint32_t)MaxLeafSize;
+                return first + count / 2;
+            }
+
+            float splitCost = TraversalCost + (parentArea > 0.0f ? bestCost / parentArea : 0.0f);
+            makeLeaf = count <= (uint32_t)MaxLeafSize && LeafBlocks(count) <= splitCost;
+            if (makeLeaf) return first + count;
+
+            float lo = centroidBox.mn[bestAxis];
+            float scale = BinCount / (centroidBox.mx[bestAxis] - lo);
+            auto begin = ctx.order.begin() + first;
+            auto mid = std::partition(begin, begin + count, [&](uint32_t tri) {
+                int b = std::min(BinCount - 1, (int)((ctx.centroids[tri].e[bestAxis] - lo) * scale));
+                return b < bestBin;
+            });
+            return (uint32_t)(mid - ctx.order.begin());
+        }
+
+        uint32_t SplitMedian(BuildContext& ctx, uint32_t first, uint32_t count, const Aabb& centroidBox) {
+            int axis = 0;
+            float extent[3];
+            for (int a = 0; a < 3; a++) extent[a] = centroidBox.mx[a] - centroidBox.mn[a];
+            if (extent[1] > extent[axis]) axis = 1;
+            if (extent[2] > extent[axis]) axis = 2;
+
+            auto begin = ctx.order.begin() + first;
+            std::nth_element(begin, begin + count / 2, begin + count, [&](uint32_t a, uint32_t b) {
+                return ctx.centroids[a].e[axis] < ctx.centroids[b].e[axis];
+            });
+            return first + count / 2;
+        }
+
+        // arenaFirst / arenaCount : worker arenas owned by this subtree (threads are split along with them)
+        BuildNode* BuildRecursive(BuildContext& ctx, uint32_t first, uint32_t count, int depth, int arenaFirst, int arenaCount) {
+            LinearArena& arena = ctx.arenas->Thread(arenaFirst);
+
+            Aabb box = Aabb::Empty(), centroidBox = Aabb::Empty();
+            for (uint32_t i = first; i < first + count; i++) {
+                uint32_t tri = ctx.order[i];
+                box.Grow(ctx.bounds[tri]);
+                centroidBox.Grow(ctx.centroids[tri].e);
+            }
+
+            if (count <= 1) return MakeLeaf(arena, box, first, count);
+
+            uint32_t mid;
+            if (depth >= MaxSahDepth) {
+                if (count <= (uint32_t)MaxLeafSize) return MakeLeaf(arena, box, first, count);
+                mid = SplitMedian(ctx, first, count, centroidBox);
+            }
+            else {
+                bool makeLeaf = false;
+                mid = SplitSah(ctx, first, count, box, centroidBox, makeLeaf);
+                if (makeLeaf) return MakeLeaf(arena, box, first, count);
+            }
+
+            BuildNode* node = arena.AllocateArray<BuildNode>(1);
+            node->box = box;
+            node->first = first;
+            node->count = count;
+
+            uint32_t leftCount = mid - first, rightCount = count - leftCount;
+            if (arenaCount > 1 && count >= ParallelMinCount) {
+                int half = arenaCount / 2;
+                std::thread worker([&]() {
+                    node->child[0] = BuildRecursive(ctx, first, leftCount, depth + 1, arenaFirst + half, arenaCount - half);
+                });
+                node->child[1] = BuildRecursive(ctx, mid, rightCount, depth + 1, arenaFirst, half);
+                worker.join();
+            }
+            else {
+                node->child[0] = BuildRecursive(ctx, first, leftCount, depth + 1, arenaFirst, arenaCount);
+                node->child[1] = BuildRecursive(ctx, mid, rightCount, depth + 1, arenaFirst, arenaCount);
+            }
+            return node;
+        }
+
+        // --- BVH8 Collapse ---
+        struct Collapser {
+            const BuildContext& ctx;
+            const std::vector<Vector3>& positions;
+            const Mesh& mesh;
+            std::vector<BvhNode8>& nodes;
+            std::vector<BvhTriangles8>& leaves;
+            int maxDepth = 0;                 // deepest inner node (root : 0)
+
+            int32_t EmitLeaf(const BuildNode* node) {
+                BvhTriangles8 leaf = {};
+                for (int i = 0; i < 8; i++) leaf.triangle[i] = -1;
+
+                for (uint32_t i = 0; i < node->count; i++) {
+                    uint32_t tri = ctx.order[node->first + i];
+                    const auto& idx = mesh.indices[tri];
+                    Vector3 p0 = positions[idx[0]], p1 = positions[idx[1]], p2 = positions[idx[2]];
+                    Vector3 e1 = p1 - p0, e2 = p2 - p0;
+                    leaf.v0x[i] = p0.x; leaf.v0y[i] = p0.y; leaf.v0z[i] = p0.z;
+                    leaf.e1x[i] = e1.x; leaf.e1y[i] = e1.y; leaf.e1z[i] = e1.z;
+                    leaf.e2x[i] = e2.x; leaf.e2y[i] = e2.y; leaf.e2z[i] = e2.z;
+                    leaf.triangle[i] = (int32_t)tri;
+                }
+                leaves.push_back(leaf);
+                return ~(int32_t)(leaves.size() - 1);
+            }
+
+            // Pull grandchildren up (largest area first) until the node has 8 children
+            int32_t EmitNode(const BuildNode* node, int depth) {
+                maxDepth = std::max(maxDepth, depth);
+                const BuildNode* children[8];
+                int n = 0;
+                if (node->child[0] == nullptr) {
+                    children[n++] = node; // leaf root
+                }
+                else {
+                    children[n++] = node->child[0];
+                    children[n++] = node->child[1];
+                }
+
+                while (n < 8) {
+                    int best = -1;
+                    float bestArea = -1.0f;
+                    for (int i = 0; i < n; i++) {
+                        if (children[i]->child[0] == nullptr) continue;
+                        float area = children[i]->box.Area();
+                        if (area > bestArea) { bestArea = area; best = i; }
+                    }
+                    if (best < 0) break;
+                    const BuildNode* inner = children[best];
+                    children[best] = inner->child[0];
+                    children[n++] = inner->child[1];
+                }
+
+                int32_t index = (int32_t)nodes.size();
+                nodes.emplace_back();
+
+                // Empty slots : inverted box, never hit
+                BvhNode8 out;
+                const float inf = std::numeric_limits<float>::infinity();
+                for (int i = 0; i < 8; i++) {
+                    out.minX[i] = out.minY[i] = out.minZ[i] = inf;
+                    out.maxX[i] = out.maxY[i] = out.maxZ[i] = -inf;
+                    out.child[i] = 0;
+                }
+                for (int i = 0; i < n; i++) {
+                    const Aabb& b = children[i]->box;
+                    out.minX[i] = b.mn[0]; out.minY[i] = b.mn[1]; out.minZ[i] = b.mn[2];
+                    out.maxX[i] = b.mx[0]; out.maxY[i] = b.mx[1]; out.maxZ[i] = b.mx[2];
+                    out.child[i] = children[i]->child[0] == nullptr ? EmitLeaf(children[i]) : EmitNode(children[i], depth + 1);
+                }
+                nodes[index] = out; // nodes may have grown during the recursion
+                return index;
+            }
+        };
+    }
+
+    void Bvh::Build(const Mesh& mesh, int threadCount) {
+        nodes.clear();
+        leaves.clear();
+        triangleCount = mesh.indices.size();
+        if (triangleCount == 0) return;
+
+        std::vector<Vector3> positions(mesh.VertexCount());
+        mesh.DecodePositions(0, positions.size(), positions.data());
+
+        threadCount = std::max(1, threadCount);
+        FrameArena arenas(threadCount, std::max<size_t>(4096, triangleCount * sizeof(BuildNode) * 2 / threadCount));
+
+        BuildContext ctx;
+        ctx.arenas = &arenas;
+        ctx.bounds.resize(triangleCount);
+        ctx.centroids.resize(triangleCount);
+        ctx.order.resize(triangleCount);
+        for (size_t t = 0; t < triangleCount; t++) {
+            const auto& idx = mesh.indices[t];
+            Aabb b = Aabb::Empty();
+            for (int k = 0; k < 3; k++) b.Grow(positions[idx[k]].e);
+            ctx.bounds[t] = b;
+            ctx.centroids[t] = Vector3((b.mn[0] + b.mx[0]) * 0.5f, (b.mn[1] + b.mx[1]) * 0.5f, (b.mn[2] + b.mx[2]) * 0.5f);
+            ctx.order[t] = (uint32_t)t;
+        }
+
+        BuildNode* root = BuildRecursive(ctx, 0, (uint32_t)triangleCount, 0, 0, threadCount);
+
+        nodes.reserve(triangleCount / 4 + 1);
+        leaves.reserve(triangleCount / 2 + 1);
+        Collapser collapser{ ctx, positions, mesh, nodes, leaves };
+        collapser.EmitNode(root, 0);
+        // The guarantee is the static_assert on MaxSahDepth : BVH8 levels never outnumber the binary ones
+        // (MaxSahDepth + median tail). This assert only catches a broken builder in debug builds
+        assert(collapser.maxDepth < BvhMaxDepth);
+
+        nodes.shrink_to_fit();
+        leaves.shrink_to_fit();
+    }
+}
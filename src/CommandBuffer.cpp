@@ -0,0 +1,232 @@
+#include "../include/CommandBuffer.h"
+#include "../include/Rasterizer.h"
+#include "../include/RenderStats.h"
+#include <algorithm>
+#include <limits>
+
+namespace Shika {
+
+    namespace {
+        const int MaxKeyBytes = 8; // bucket (1 - 16) | material 16 | textured 1 | depth 15 | stream 16
+
+        // Batch state of a sorted key : material 16 | stream 16
+        uint32_t BatchState(uint64_t key) { return (uint32_t)((key >> 16) & 0xFFFF0000u) | (uint32_t)(key & 0xFFFF); }
+
+        // Vertices & triangles of one draw id, ready for the rasterizer
+        struct Stream {
+            const Vector3* screen;
+            const TexCoord* uvs;                 // nullptr : flat
+            const std::array<int, 3>* triangles;
+            size_t count;
+            int material;
+            const int* triangleMaterials;        // loose triangles : one material each
+            TriangleSetup* setups;               // visible triangles (setup stage output)
+            size_t visible;
+        };
+
+        // Stable LSD radix sort of (key, value) pairs, 8 bits per pass over key bytes [firstByte, lastByte)
+        // Passes where every key has the same digit are skipped (e.g. a single material)
+        // The buffers are swapped so that keys / values hold the result
+        void RadixSort(uint64_t*& keys, uint32_t*& values, uint64_t*& tmpKeys, uint32_t*& tmpValues, size_t count, int firstByte, int lastByte) {
+            size_t histogram[MaxKeyBytes][256] = {};
+            for (size_t i = 0; i < count; i++) {
+                uint64_t key = keys[i];
+                for (int b = firstByte; b < lastByte; b++) histogram[b][(key >> (8 * b)) & 0xFF]++;
+            }
+
+            for (int b = firstByte; b < lastByte; b++) {
+                size_t* h = histogram[b];
+                if (h[(keys[0] >> (8 * b)) & 0xFF] == count) continue;
+
+                size_t sum = 0;
+                for (int d = 0; d < 256; d++) {
+                    size_t n = h[d];
+                    h[d] = sum;
+                    sum += n;
+                }
+                for (size_t i = 0; i < count; i++) {
+                    size_t slot = h[(keys[i] >> (8 * b)) & 0xFF]++;
+                    tmpKeys[slot] = keys[i];
+                    tmpValues[slot] = values[i];
+                }
+                std::swap(keys, tmpKeys);
+                std::swap(values, tmpValues);
+            }
+        }
+    }
+
+    int CommandBuffer::AddMaterial(Color color) {
+        if (materials.size() >= MaxMaterials) return -1;
+        materials.push_back({ nullptr, color });
+        return (int)materials.size() - 1;
+    }
+
+    int CommandBuffer::AddMaterial(const Texture& texture, Color tint) {
+        if (materials.size() >= MaxMaterials) return -1;
+        materials.push_back({ &texture, tint });
+        return (int)materials.size() - 1;
+    }
+
+    bool CommandBuffer::Submit(const Mesh& mesh, const Matrix4x4& mvpMatrix, int material) {
+        if (material < 0 || (size_t)material >= materials.size() || draws.size() >= MaxDraws) return false;
+        draws.push_back({ &mesh, mvpMatrix, material });
+        return true;
+    }
+
+    bool CommandBuffer::SubmitTriangle(const Vector3& v0, const Vector3& v1, const Vector3& v2, int material) {
+        if (material < 0 || (size_t)material >= materials.size()) return false;
+        flatTriangles.push_back({ { v0, v1, v2 }, {}, material });
+        return true;
+    }
+
+    bool CommandBuffer::SubmitTriangle(const Vector3& v0, const Vector3& v1, const Vector3& v2,
+                                       TexCoord t0, TexCoord t1, TexCoord t2, int material) {
+        if (material < 0 || (size_t)material >= materials.size()) return false;
+        texturedTriangles.push_back({ { v0, v1, v2 }, { t0, t1, t2 }, material });
+        return true;
+    }
+
+    void CommandBuffer::Reset() {
+        draws.clear();
+        flatTriangles.clear();
+        texturedTriangles.clear();
+    }
+
+    void CommandBuffer::Execute(Canvas& canvas, LinearArena& arena) {
+        sortedTriangles = 0;
+        batchCount = 0;
+
+        // --- Streams : mesh draws, then the loose flat & textured triangles ---
+        const size_t streamCount = draws.size() + 2;
+        Stream* streams = arena.AllocateArray<Stream>(streamCount);
+        size_t total = 0;
+
+        for (size_t d = 0; d < draws.size(); d++) {
+            const Draw& draw = draws[d];
+            const Mesh& mesh = *draw.mesh;
+            Stream& s = streams[d];
+            s.screen = Rasterizer::ProjectMesh(canvas, mesh, draw.mvp, arena);
+            s.uvs = nullptr;
+            if (materials[draw.material].texture != nullptr && mesh.uvs.size() >= mesh.VertexCount()) {
+                TexCoord* uvs = arena.AllocateArray<TexCoord>(mesh.VertexCount());
+                mesh.DecodeUVs(0, mesh.VertexCount(), &uvs[0].u);
+                s.uvs = uvs;
+            }
+            s.triangles = mesh.indices.data();
+            s.count = mesh.indices.size();
+            s.material = draw.material;
+            s.triangleMaterials = nullptr;
+            total += s.count;
+        }
+
+        const std::vector<LooseTriangle>* looseLists[2] = { &flatTriangles, &texturedTriangles };
+        for (int l = 0; l < 2; l++) {
+            const std::vector<LooseTriangle>& list = *looseLists[l];
+            const size_t n = list.size();
+            Vector3* screen = arena.AllocateArray<Vector3>(3 * n);
+            TexCoord* uvs = l == 1 ? arena.AllocateArray<TexCoord>(3 * n) : nullptr;
+            std::array<int, 3>* triangles = arena.AllocateArray<std::array<int, 3>>(n);
+            int* triangleMaterials = arena.AllocateArray<int>(n);
+            for (size_t i = 0; i < n; i++) {
+                for (int k = 0; k < 3; k++) {
+                    screen[3 * i + k] = list[i].v[k];
+                    if (uvs) uvs[3 * i + k] = list[i].t[k];
+                }
+                triangles[i] = { (int)(3 * i), (int)(3 * i + 1), (int)(3 * i + 2) };
+                triangleMaterials[i] = list[i].material;
+            }
+
+            Stream& s = streams[draws.size() + l];
+            s = { screen, uvs, triangles, n, 0, triangleMaterials, nullptr, 0 };
+            total += n;
+        }
+        if (total == 0) return;
+
+        // --- Setup stage : culled triangles never reach the sort ---
+        TriangleSetup* setups = arena.AllocateArray<TriangleSetup>(total);
+        size_t visible = 0;
+        for (size_t d = 0; d < streamCount; d++) {
+            Stream& s = streams[d];
+            s.setups = setups + visible;
+            s.visible = Rasterizer::SetupTriangles(canvas, s.screen, s.triangles, s.count, s.setups);
+            visible += s.visible;
+        }
+        if (visible == 0) return;
+
+        uint64_t* keys = arena.AllocateArray<uint64_t>(visible);
+        uint32_t* values = arena.AllocateArray<uint32_t>(visible);
+        float* depth = arena.AllocateArray<float>(visible);
+
+        {
+            SHIKA_STATS_SCOPE(RenderStage::Setup);
+
+            // --- Keys ---
+            // Flat records carry their screen space vertices : every flat material batches under the
+            // flat loose stream, only textured draws keep their own stream (per-draw uvs & indices)
+            const uint64_t flatStream = draws.size();
+            float zMin = std::numeric_limits<float>::max();
+            float zMax = -std::numeric_limits<float>::max();
+            size_t n = 0;
+            for (size_t d = 0; d < streamCount; d++) {
+                const Stream& s = streams[d];
+                for (size_t i = 0; i < s.visible; i++, n++) {
+                    const TriangleSetup& setup = s.setups[i];
+                    float z = std::min({ setup.z[0], setup.z[1], setup.z[2] });
+                    int material = s.triangleMaterials ? s.triangleMaterials[setup.triangle] : s.material;
+                    uint64_t stream = materials[material].texture != nullptr && s.uvs != nullptr ? d : flatStream;
+                    depth[n] = z;
+                    keys[n] = ((uint64_t)material << 48) | (stream << 32);
+                    values[n] = (uint32_t)n;
+                    zMin = std::min(zMin, z);
+                    zMax = std::max(zMax, z);
+                }
+            }
+
+            // Quantize the nearest depth over [zMin, zMax] (NaN goes first)
+            const float maxDepth = 65535.0f;
+            const float scale = zMax > zMin ? maxDepth / (zMax - zMin) : 0.0f;
+            for (size_t i = 0; i < visible; i++) {
+                float q = (depth[i] - zMin) * scale;
+                keys[i] |= q > 0.0f ? (uint64_t)std::min(q, maxDepth) : 0;
+            }
+
+            // A single triangle skips every pass, its key is still rebuilt
+            uint64_t* tmpKeys = arena.AllocateArray<uint64_t>(visible);
+            uint32_t* tmpValues = arena.AllocateArray<uint32_t>(visible);
+
+            // Depth passes first, then the buckets hold the same number of triangles each
+            // (perspective depth crowds near 1, equal depth ranges would leave most buckets empty)
+            RadixSort(keys, values, tmpKeys, tmpValues, visible, 0, 2);
+            for (size_t i = 0; i < visible; i++) {
+                uint64_t material = keys[i] >> 48;
+                uint64_t stream = (keys[i] >> 32) & 0xFFFF;
+                uint64_t textured = stream != flatStream;
+                keys[i] = ((uint64_t)((i << depthBits) / visible) << 48) | (material << 32) | (textured << 31) |
+                          ((keys[i] & 0xFFFF) >> 1 << 16) | stream;
+            }
+            // The stream bytes are left in depth order : they only split batches at equal depths
+            RadixSort(keys, values, tmpKeys, tmpValues, visible, 2, (48 + depthBits + 7) / 8);
+        }
+        sortedTriangles = visible;
+
+        // --- Execute : runs of the same material & stream share one batch ---
+        TriangleSetup* sorted = arena.AllocateArray<TriangleSetup>(visible);
+        for (size_t i = 0; i < visible; i++) sorted[i] = setups[values[i]];
+
+        for (size_t first = 0; first < visible; ) {
+            const uint32_t state = BatchState(keys[first]);
+            size_t last = first + 1;
+            while (last < visible && BatchState(keys[last]) == state) last++;
+
+            const Stream& s = streams[state & 0xFFFF];
+            const Material& material = materials[state >> 16];
+            if (material.texture != nullptr && s.uvs != nullptr) {
+                Rasterizer::DrawTriangles(canvas, sorted + first, last - first, s.uvs, s.triangles, *material.texture, material.color);
+            } else {
+                Rasterizer::DrawTriangles(canvas, sorted + first, last - first, material.color);
+            }
+            batchCount++;
+            first = last;
+        }
+    }
+}
@@ -0,0 +1,126 @@
+#include "../include/CpuDispatch.h"
+#include "kernels/Kernels.h"
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
+#include <iostream>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#else
+    #include <cpuid.h>
+#endif
+
+namespace Shika {
+
+    // --- CPUID Helpers ---
+    static void CpuId(unsigned int leaf, unsigned int subLeaf, unsigned int regs[4]) {
+    #if defined(_MSC_VER)
+        int r[4];
+        __cpuidex(r, (int)leaf, (int)subLeaf);
+        for (int i = 0; i < 4; i++) regs[i] = (unsigned int)r[i];
+    #else
+        __cpuid_count(leaf, subLeaf, regs[0], regs[1], regs[2], regs[3]);
+    #endif
+    }
+
+    // XCR0 : register states enabled by the OS
+    static unsigned long long XGetBV() {
+    #if defined(_MSC_VER)
+        return _xgetbv(0);
+    #else
+        unsigned int lo, hi;
+        __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+        return ((unsigned long long)hi << 32) | lo;
+    #endif
+    }
+
+    SimdLevel DetectSimdLevel() {
+        unsigned int r[4];
+        CpuId(0, 0, r);
+        unsigned int maxLeaf = r[0];
+
+        CpuId(1, 0, r);
+        bool sse41   = (r[2] & (1u << 19)) != 0;
+        bool fma     = (r[2] & (1u << 12)) != 0;
+        bool f16c    = (r[2] & (1u << 29)) != 0;
+        bool osxsave = (r[2] & (1u << 27)) != 0;
+        bool avx     = (r[2] & (1u << 28)) != 0;
+        (void)sse41; // Baseline : the library is built for SSE4.1
+
+        if (!osxsave || !avx || !fma || !f16c || maxLeaf < 7) return SimdLevel::SSE41;
+
+        unsigned long long xcr0 = XGetBV();
+        // XMM | YMM state
+        if ((xcr0 & 0x6) != 0x6) return SimdLevel::SSE41;
+
+        CpuId(7, 0, r);
+        bool avx2    = (r[1] & (1u << 5)) != 0;
+        bool avx512f = (r[1] & (1u << 16)) != 0;
+
+        if (!avx2) return SimdLevel::SSE41;
+
+        // opmask | ZMM_Hi256 | Hi16_ZMM state
+        if (avx512f && (xcr0 & 0xE0) == 0xE0) return SimdLevel::AVX512;
+
+        return SimdLevel::AVX2;
+    }
+
+    // Parse SHIKA_SIMD (case insensitive), return false if unset or unknown
+    static bool ReadSimdOverride(SimdLevel& level) {
+        const char* env = std::getenv("SHIKA_SIMD");
+        if (env == nullptr || env[0] == '\0') return false;
+
+        char name[16] = {};
+        for (int i = 0; i < 15 && env[i] != '\0'; i++) {
+            name[i] = (char)std::tolower((unsigned char)env[i]);
+        }
+
+        if (std::strcmp(name, "sse41") == 0 || std::strcmp(name, "sse4.1") == 0) { level = SimdLevel::SSE41; return true; }
+        if (std::strcmp(name, "avx2") == 0) { level = SimdLevel::AVX2; return true; }
+        if (std::strcmp(name, "avx512") == 0) { level = SimdLevel::AVX512; return true; }
+
+        std::cerr << "Warning: Unknown SHIKA_SIMD value " << env << ", using auto detection" << std::endl;
+        return false;
+    }
+
+    static SimdLevel SelectSimdLevel() {
+        SimdLevel detected = DetectSimdLevel();
+        SimdLevel requested;
+        if (!ReadSimdOverride(requested)) return detected;
+
+        if ((int)requested > (int)detected) {
+            std::cerr << "Warning: SHIKA_SIMD=" << SimdLevelName(requested)
+                      << " is not supported by this CPU, using " << SimdLevelName(detected) << std::endl;
+            return detected;
+        }
+        return requested;
+    }
+
+    SimdLevel GetSimdLevel() {
+        static const SimdLevel level = SelectSimdLevel();
+        return level;
+    }
+
+    const char* SimdLevelName(SimdLevel level) {
+        switch (level) {
+            case SimdLevel::SSE41:  return "sse41";
+            case SimdLevel::AVX2:   return "avx2";
+            case SimdLevel::AVX512: return "avx512";
+        }
+        return "unknown";
+    }
+
+    const KernelTable& GetKernels(SimdLevel level) {
+        switch (level) {
+            case SimdLevel::AVX512: return Kernels::TableAVX512;
+            case SimdLevel::AVX2:   return Kernels::TableAVX2;
+            default:                return Kernels::TableSSE41;
+        }
+    }
+
+    const KernelTable& GetKernels() {
+        static const KernelTable& table = GetKernels(GetSimdLevel());
+        return table;
+    }
+}
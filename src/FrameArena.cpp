@@ -0,0 +1,65 @@
+#include "../include/FrameArena.h"
+#include <new>
+#include <algorithm>
+
+namespace Shika {
+
+    LinearArena::LinearArena(size_t initialCapacity) {
+        PushBlock(std::max<size_t>(initialCapacity, BlockAlignment));
+    }
+
+    LinearArena::~LinearArena() {
+        while (current) {
+            Block* prev = current->prev;
+            ::operator delete(current, std::align_val_t(BlockAlignment));
+            current = prev;
+        }
+    }
+
+    void LinearArena::PushBlock(size_t size) {
+        void* memory = ::operator new(BlockAlignment + size, std::align_val_t(BlockAlignment));
+        Block* block = static_cast<Block*>(memory);
+        block->prev = current;
+        block->size = size;
+
+        current = block;
+        cursor = BlockData(block);
+        end = cursor + size;
+        capacity += size;
+        blockAllocations++;
+    }
+
+    void* LinearArena::AllocateSlow(size_t size, size_t align) {
+        // Chain a new block (at least double the capacity) for the rest of the frame
+        retired += (size_t)(cursor - BlockData(current));
+        PushBlock(std::max(capacity, size + align));
+
+        uintptr_t p = ((uintptr_t)cursor + (align - 1)) & ~(uintptr_t)(align - 1);
+        cursor = (char*)(p + size);
+        return (void*)p;
+    }
+
+    void LinearArena::Reset() {
+        retired = 0;
+
+        // Steady state : a single block, just rewind
+        if (current->prev == nullptr) {
+            cursor = BlockData(current);
+            return;
+        }
+
+        // The frame overflowed : coalesce into one block of the total size
+        size_t total = capacity;
+        while (current) {
+            Block* prev = current->prev;
+            ::operator delete(current, std::align_val_t(BlockAlignment));
+            current = prev;
+        }
+        capacity = 0;
+        PushBlock(total);
+    }
+
+    size_t LinearArena::Used() const {
+        return retired + (size_t)(cursor - BlockData(current));
+    }
+}
@@ -0,0 +1,216 @@
+#include "../include/FramePipeline.h"
+#include <algorithm>
+#include <iostream>
+
+namespace Shika {
+
+    // --- PPM Sequence ---
+    bool PpmSequenceSink::WriteFrame(const uint8_t* rgb, int width, int height) {
+        std::vector<char> name(pattern.size() + 32);
+        std::snprintf(name.data(), name.size(), pattern.c_str(), frameIndex++);
+
+        std::FILE* f = std::fopen(name.data(), "wb");
+        if (!f) {
+            std::cerr << "Error: Could not open file " << name.data() << std::endl;
+            return false;
+        }
+        std::fprintf(f, "P6\n%d %d\n255\n", width, height);
+        size_t size = (size_t)width * height * 3;
+        bool ok = std::fwrite(rgb, 1, size, f) == size;
+        return std::fclose(f) == 0 && ok;
+    }
+
+    // --- Streams ---
+    StreamSink::StreamSink(const std::string& path) {
+        if (path == "-") {
+            file = stdout;
+            return;
+        }
+        file = std::fopen(path.c_str(), "wb");
+        owned = file != nullptr;
+        if (!file) std::cerr << "Error: Could not open file " << path << std::endl;
+    }
+
+    StreamSink::~StreamSink() {
+        Finish();
+    }
+
+    bool StreamSink::Write(const void* data, size_t size) {
+        return file != nullptr && std::fwrite(data, 1, size, file) == size;
+    }
+
+    bool StreamSink::Finish() {
+        if (!file) return false;
+        bool ok = std::fflush(file) == 0;
+        if (owned) ok = std::fclose(file) == 0 && ok;
+        file = nullptr;
+        return ok;
+    }
+
+    bool RawVideoSink::WriteFrame(const uint8_t* rgb, int width, int height) {
+        return Write(rgb, (size_t)width * height * 3);
+    }
+
+    // --- Y4M ---
+    namespace {
+        // BT.601 limited range, 8-bit fixed point
+        inline uint8_t LumaBT601(int r, int g, int b) {
+            return (uint8_t)((66 * r + 129 * g + 25 * b + 128 + (16 << 8)) >> 8);
+        }
+        inline uint8_t CbBT601(int r, int g, int b) {
+            return (uint8_t)((-38 * r - 74 * g + 112 * b + 128 + (128 << 8)) >> 8);
+        }
+        inline uint8_t CrBT601(int r, int g, int b) {
+            return (uint8_t)((112 * r - 94 * g - 18 * b + 128 + (128 << 8)) >> 8);
+        }
+    }
+
+    bool Y4mSink::WriteFrame(const uint8_t* rgb, int width, int height) {
+        if (streamWidth == 0) {
+            if (!file) return false;
+            std::fprintf(file, "YUV4MPEG2 W%d H%d F%d:%d Ip A1:1 %s\n", width, height, fpsNum, fpsDen,
+                         chroma == Y4mChroma::C420 ? "C420jpeg" : "C444");
+            streamWidth = width;
+            streamHeight = height;
+        }
+        // Every frame of a stream has the header size
+        if (width != streamWidth || height != streamHeight) return false;
+
+        const size_t lumaSize = (size_t)width * height;
+        const int cw = chroma == Y4mChroma::C420 ? (width + 1) / 2 : width;
+        const int ch = chroma == Y4mChroma::C420 ? (height + 1) / 2 : height;
+        const size_t chromaSize = (size_t)cw * ch;
+        planes.resize(lumaSize + 2 * chromaSize);
+        uint8_t* Y = planes.data();
+        uint8_t* U = Y + lumaSize;
+        uint8_t* V = U + chromaSize;
+
+        for (size_t i = 0; i < lumaSize; i++) {
+            Y[i] = LumaBT601(rgb[3 * i], rgb[3 * i + 1], rgb[3 * i + 2]);
+        }
+
+        if (chroma == Y4mChroma::C444) {
+            for (size_t i = 0; i < lumaSize; i++) {
+                U[i] = CbBT601(rgb[3 * i], rgb[3 * i + 1], rgb[3 * i + 2]);
+                V[i] = CrBT601(rgb[3 * i], rgb[3 * i + 1], rgb[3 * i + 2]);
+            }
+        }
+        else {
+            // Average of the 2x2 block (edge pixels repeated on odd sizes)
+            for (int y = 0; y < ch; y++) {
+                const uint8_t* row0 = rgb + (size_t)(2 * y) * width * 3;
+                const uint8_t* row1 = rgb + (size_t)std::min(2 * y + 1, height - 1) * width * 3;
+                for (int x = 0; x < cw; x++) {
+                    int x0 = 3 * (2 * x), x1 = 3 * std::min(2 * x + 1, width - 1);
+                    int r = (row0[x0] + row0[x1] + row1[x0] + row1[x1] + 2) >> 2;
+                    int g = (row0[x0 + 1] + row0[x1 + 1] + row1[x0 + 1] + row1[x1 + 1] + 2) >> 2;
+                    int b = (row0[x0 + 2] + row0[x1 + 2] + row1[x0 + 2] + row1[x1 + 2] + 2) >> 2;
+                    U[(size_t)y * cw + x] = CbBT601(r, g, b);
+                    V[(size_t)y * cw + x] = CrBT601(r, g, b);
+                }
+            }
+        }
+
+        return Write("FRAME\n", 6) && Write(planes.data(), planes.size());
+    }
+
+    // --- Frame Pipeline ---
+    FramePipeline::FramePipeline(int width, int height, FrameSink& frameSink, int ringSize) : sink(frameSink) {
+        ringSize = std::max(ringSize, 2);
+        for (int i = 0; i < ringSize; i++) {
+            canvases.emplace_back(new Canvas(width, height));
+            freeCanvases.push_back(i);
+        }
+        encoder = std::thread(&FramePipeline::EncoderLoop, this);
+    }
+
+    FramePipeline::~FramePipeline() {
+        Finish();
+    }
+
+    Canvas& FramePipeline::BeginFrame(const Color& clearColor) {
+        if (current < 0) {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (freeCanvases.empty()) {
+                stalls++;
+                freeCondition.wait(lock, [this] { return !freeCanvases.empty(); });
+            }
+            current = freeCanvases.front();
+            freeCanvases.pop_front();
+        }
+
+        Canvas& canvas = *canvases[current];
+        canvas.Clear(clearColor);
+        canvas.ClearDepth();
+        return canvas;
+    }
+
+    void FramePipeline::EndFrame() {
+        if (current < 0) return;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            // After Finish nothing encodes anymore : the frame is dropped
+            if (stopping) freeCanvases.push_back(current);
+            else readyCanvases.push_back(current);
+        }
+        current = -1;
+        submitted++;
+        readyCondition.notify_one();
+    }
+
+    bool FramePipeline::Finish() {
+        if (encoder.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            readyCondition.notify_one();
+            encoder.join();
+            if (!sink.Finish()) failed = true;
+        }
+        return !failed;
+    }
+
+    size_t FramePipeline::FramesWritten() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return written;
+    }
+
+    size_t FramePipeline::Stalls() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return stalls;
+    }
+
+    void FramePipeline::EncoderLoop() {
+        std::vector<uint8_t> rgb;
+        while (true) {
+            int index;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                readyCondition.wait(lock, [this] { return stopping || !readyCanvases.empty(); });
+                if (readyCanvases.empty()) return; // stopping & drained
+                index = readyCanvases.front();
+                readyCanvases.pop_front();
+            }
+
+            const Canvas& canvas = *canvases[index];
+            const int width = canvas.GetWidth(), height = canvas.GetHeight();
+            canvas.ConvertToRGB8(rgb);
+
+            // The canvas is free again : the next frame renders while the sink writes
+            bool drop;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                freeCanvases.push_back(index);
+                drop = failed;
+            }
+            freeCondition.notify_one();
+
+            if (drop) continue;
+            bool ok = sink.WriteFrame(rgb.data(), width, height);
+            std::lock_guard<std::mutex> lock(mutex);
+            if (ok) written++;
+            else failed = true;
+        }
+    }
+}
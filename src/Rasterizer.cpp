@@ -4,55 +4,201 @@
 
 namespace Shika {
 
-    static inline float EdgeFunction(const Vector3& v0, const Vector3& v1, const Vector3& p) {
-        return (p.x - v0.x) * (v1.y - v0.y) - (p.y - v0.y) * (v1.x - v0.x);
+    // Row start values of the edge functions & depth (first pixel centre of row y)
+    static inline void SetupRow(RasterRowSetup& row, const TriangleSetup& s, int y, float invArea) {
+        const float px = (float)s.minX + 0.5f, py = (float)y + 0.5f;
+
+        // Edge Function about 3 sides (origins v1, v2, v0)
+        row.w0 = (px - s.x[1]) * s.dwdx[0] + (py - s.y[1]) * s.dwdy[0]; // v1 -> v2
+        row.w1 = (px - s.x[2]) * s.dwdx[1] + (py - s.y[2]) * s.dwdy[1]; // v2 -> v0
+        row.w2 = (px - s.x[0]) * s.dwdx[2] + (py - s.y[0]) * s.dwdy[2]; // v0 -> v1
+
+        // Depth Interpolation (alpha + beta + gamma = 1)
+        row.z = (row.w0 * s.z[0] + row.w1 * s.z[1] + row.w2 * s.z[2]) * invArea;
+    }
+
+    static void RasterFlat(Canvas& canvas, const TriangleSetup& s, Color color) {
+        SHIKA_STATS_SCOPE(RenderStage::Raster);
+        SHIKA_STATS_ADD(trianglesRasterized, 1);
+
+        // Edge functions & depth are linear in x : step them inside the SIMD row kernel
+        float invArea = 1.0f / s.area;
+        RasterRowSetup row;
+        row.dw0 = s.dwdx[0];
+        row.dw1 = s.dwdx[1];
+        row.dw2 = s.dwdx[2];
+        row.dz  = (row.dw0 * s.z[0] + row.dw1 * s.z[1] + row.dw2 * s.z[2]) * invArea;
+
+        const KernelTable& kernels = GetKernels();
+        const int width = canvas.GetWidth();
+        const int span = s.maxX - s.minX + 1;
+        float* depth = canvas.DepthData();
+        float* rgb = reinterpret_cast<float*>(canvas.PixelData());
+
+        for (int y = s.minY; y <= s.maxY; y++) {
+            SetupRow(row, s, y, invArea);
+
+            int offset = y * width + s.minX;
+        #if defined(SHIKA_ENABLE_STATS)
+            uint16_t* overdrawRow = Stats::OverdrawRow(width, canvas.GetHeight(), y);
+            RasterRowStats rowStats = { 0, overdrawRow ? overdrawRow + s.minX : nullptr };
+            int written = kernels.RasterRow(row, span, depth + offset, rgb + 3 * offset, &color.r, &rowStats);
+
+            SHIKA_STATS_ADD(pixelsTested, span);
+            SHIKA_STATS_ADD(pixelsCovered, rowStats.covered);
+            SHIKA_STATS_ADD(depthPass, written);
+            SHIKA_STATS_ADD(depthFail, rowStats.covered - written);
+        #else
+            kernels.RasterRow(row, span, depth + offset, rgb + 3 * offset, &color.r, nullptr);
+        #endif
+        }
+    }
+
+    // Textured fill with the texture state already bound (view built once per batch)
+    static void RasterTextured(Canvas& canvas, const TriangleSetup& s, TexCoord t0, TexCoord t1, TexCoord t2,
+                               const TextureView& view, Color tint) {
+        SHIKA_STATS_SCOPE(RenderStage::Raster);
+        SHIKA_STATS_ADD(trianglesRasterized, 1);
+
+        float invArea = 1.0f / s.area;
+        RasterRowSetup row;
+        row.dw0 = s.dwdx[0];
+        row.dw1 = s.dwdx[1];
+        row.dw2 = s.dwdx[2];
+        row.dz  = (row.dw0 * s.z[0] + row.dw1 * s.z[1] + row.dw2 * s.z[2]) * invArea;
+
+        // u / w, v / w, 1 / w are linear in screen space (affine if the vertices carry no 1 / w)
+        float q0 = s.q[0], q1 = s.q[1], q2 = s.q[2];
+        if (q0 == 0.0f || q1 == 0.0f || q2 == 0.0f) q0 = q1 = q2 = 1.0f;
+        const float U0 = t0.u * q0, U1 = t1.u * q1, U2 = t2.u * q2;
+        const float V0 = t0.v * q0, V1 = t1.v * q1, V2 = t2.v * q2;
+
+        TexturedRowSetup uv;
+        uv.dudx = (row.dw0 * U0 + row.dw1 * U1 + row.dw2 * U2) * invArea;
+        uv.dvdx = (row.dw0 * V0 + row.dw1 * V1 + row.dw2 * V2) * invArea;
+        uv.dqdx = (row.dw0 * q0 + row.dw1 * q1 + row.dw2 * q2) * invArea;
+        uv.dudy = (s.dwdy[0] * U0 + s.dwdy[1] * U1 + s.dwdy[2] * U2) * invArea;
+        uv.dvdy = (s.dwdy[0] * V0 + s.dwdy[1] * V1 + s.dwdy[2] * V2) * invArea;
+        uv.dqdy = (s.dwdy[0] * q0 + s.dwdy[1] * q1 + s.dwdy[2] * q2) * invArea;
+
+        const KernelTable& kernels = GetKernels();
+        const int width = canvas.GetWidth();
+        const int span = s.maxX - s.minX + 1;
+        float* depth = canvas.DepthData();
+        float* rgb = reinterpret_cast<float*>(canvas.PixelData());
+
+        for (int y = s.minY; y <= s.maxY; y++) {
+            SetupRow(row, s, y, invArea);
+            uv.u = (row.w0 * U0 + row.w1 * U1 + row.w2 * U2) * invArea;
+            uv.v = (row.w0 * V0 + row.w1 * V1 + row.w2 * V2) * invArea;
+            uv.q = (row.w0 * q0 + row.w1 * q1 + row.w2 * q2) * invArea;
+
+            int offset = y * width + s.minX;
+        #if defined(SHIKA_ENABLE_STATS)
+            uint16_t* overdrawRow = Stats::OverdrawRow(width, canvas.GetHeight(), y);
+            RasterRowStats rowStats = { 0, overdrawRow ? overdrawRow + s.minX : nullptr };
+            int written = kernels.RasterRowTextured(row, uv, view, span, depth + offset, rgb + 3 * offset, &tint.r, &rowStats);
+
+            SHIKA_STATS_ADD(pixelsTested, span);
+            SHIKA_STATS_ADD(pixelsCovered, rowStats.covered);
+            SHIKA_STATS_ADD(depthPass, written);
+            SHIKA_STATS_ADD(depthFail, rowStats.covered - written);
+        #else
+            kernels.RasterRowTextured(row, uv, view, span, depth + offset, rgb + 3 * offset, &tint.r, nullptr);
+        #endif
+        }
+    }
+
+    size_t Rasterizer::SetupTriangles(const Canvas& canvas, const Vector3* screen, const std::array<int, 3>* triangles,
+                                      size_t count, TriangleSetup* out) {
+        SHIKA_STATS_SCOPE(RenderStage::Setup);
+        TriangleSetupCounts counts = { 0, 0, 0, 0 };
+        size_t visible = GetKernels().SetupTriangles(reinterpret_cast<const float*>(screen), reinterpret_cast<const int32_t*>(triangles),
+                                                     count, canvas.GetWidth(), canvas.GetHeight(), out, &counts);
+        SHIKA_STATS_ADD(trianglesSubmitted, count);
+        SHIKA_STATS_ADD(trianglesCulledZeroArea, counts.zeroArea);
+        SHIKA_STATS_ADD(trianglesCulledBackface, counts.backface);
+        SHIKA_STATS_ADD(trianglesCulledFrustum, counts.frustum);
+        SHIKA_STATS_ADD(trianglesCulledSubPixel, counts.subPixel);
+        return visible;
+    }
+
+    void Rasterizer::DrawTriangles(Canvas& canvas, const TriangleSetup* setups, size_t count, Color color) {
+        for (size_t i = 0; i < count; i++) RasterFlat(canvas, setups[i], color);
+    }
+
+    void Rasterizer::DrawTriangles(Canvas& canvas, const TriangleSetup* setups, size_t count, const TexCoord* uvs,
+                                   const std::array<int, 3>* triangles, const Texture& texture, Color tint) {
+        const TextureView view = texture.View();
+        for (size_t i = 0; i < count; i++) {
+            const auto& tri = triangles[setups[i].triangle];
+            RasterTextured(canvas, setups[i], uvs[tri[0]], uvs[tri[1]], uvs[tri[2]], view, tint);
+        }
     }
 
     void Rasterizer::DrawFilledTriangle(Canvas& canvas, const Vector3& v0, const Vector3& v1, const Vector3& v2, Color color) {
-        // Calculate Bounding Box
-        int minX = (int)std::floor(std::min({v0.x, v1.x, v2.x}));
-        int minY = (int)std::floor(std::min({v0.y, v1.y, v2.y}));
-        int maxX = (int)std::ceil(std::max({v0.x, v1.x, v2.x}));
-        int maxY = (int)std::ceil(std::max({v0.y, v1.y, v2.y}));
-
-        // Clipping
-        minX = std::max(minX, 0);
-        minY = std::max(minY, 0);
-        maxX = std::min(maxX, canvas.GetWidth() - 1);
-        maxY = std::min(maxY, canvas.GetHeight() - 1);
-
-        // The Area of the Triangle
-        float area = EdgeFunction(v0, v1, v2);
-
-        if (area >= 0) return;
-
-        for (int y = minY; y <= maxY; y++) {
-            for (int x = minX; x <= maxX; x++) {
-                // Miidle point of Pixel (+0.5f)
-                Vector3 p((float)x + 0.5f, (float)y + 0.5f, 0.0f);
-
-                // Edge Function Test about 3 sides
-                float w0 = EdgeFunction(v1, v2, p); // v1 -> v2 
-                float w1 = EdgeFunction(v2, v0, p); // v2 -> v0 
-                float w2 = EdgeFunction(v0, v1, p); // v0 -> v1 
-
-                // Put Pixef if pass Edge Test
-                if (w0 <= 0 && w1 <= 0 && w2 <= 0) {
-                    // alpha + beta + gamma = 1
-                    float alpha = w0 / area;
-                    float beta  = w1 / area;
-                    float gamma = w2 / area;
-
-                    // Depth Interpolation
-                    float z = alpha * v0.z + beta * v1.z + gamma * v2.z;
-
-                    if (z < canvas.GetDepth(x, y)) {
-                        canvas.SetDepth(x, y, z);      // Depth Update
-                        canvas.PutPixel(x, y, color);  // Color Update
-                    }
-                }
+        const Vector3 screen[3] = { v0, v1, v2 };
+        const std::array<int, 3> triangle = { 0, 1, 2 };
+        TriangleSetup setup;
+        if (SetupTriangles(canvas, screen, &triangle, 1, &setup) == 1) RasterFlat(canvas, setup, color);
+    }
+
+    void Rasterizer::DrawFilledTriangle(Canvas& canvas, const Vector3& v0, const Vector3& v1, const Vector3& v2,
+                                        TexCoord t0, TexCoord t1, TexCoord t2, const Texture& texture, Color tint) {
+        const Vector3 screen[3] = { v0, v1, v2 };
+        const std::array<int, 3> triangle = { 0, 1, 2 };
+        TriangleSetup setup;
+        if (SetupTriangles(canvas, screen, &triangle, 1, &setup) == 1) RasterTextured(canvas, setup, t0, t1, t2, texture.View(), tint);
+    }
+
+    void Rasterizer::DrawTriangles(Canvas& canvas, const Vector3* screen, const TexCoord* uvs,
+                                   const std::array<int, 3>* triangles, size_t count, const Texture* texture, Color color) {
+        // Setup records of one chunk stay in L1 until they are rasterized
+        const size_t chunk = 128;
+        TriangleSetup setups[chunk];
+
+        for (size_t first = 0; first < count; first += chunk) {
+            size_t n = std::min(chunk, count - first);
+            size_t visible = SetupTriangles(canvas, screen, triangles + first, n, setups);
+            if (texture == nullptr || uvs == nullptr) DrawTriangles(canvas, setups, visible, color);
+            else DrawTriangles(canvas, setups, visible, uvs, triangles + first, *texture, color);
+        }
+    }
+
+    Vector3* Rasterizer::ProjectMesh(const Canvas& canvas, const Mesh& mesh, const Matrix4x4& mvpMatrix, LinearArena& arena) {
+        size_t count = mesh.VertexCount();
+        Vector3* screen = arena.AllocateArray<Vector3>(count);
+
+        if (mesh.positionFormat == VertexFormat::Float3Aligned) {
+            Rasterizer::TransformVertices(mesh.vertices.data(), screen, count, mvpMatrix, canvas.GetWidth(), canvas.GetHeight());
+        } else {
+            // Compact storage : decode in L1-sized chunks right before the transform
+            const size_t chunk = 256;
+            Vector3* decoded = arena.AllocateArray<Vector3>(std::min(chunk, count));
+            for (size_t first = 0; first < count; first += chunk) {
+                size_t n = std::min(chunk, count - first);
+                mesh.DecodePositions(first, n, decoded);
+                Rasterizer::TransformVertices(decoded, screen + first, n, mvpMatrix, canvas.GetWidth(), canvas.GetHeight());
             }
         }
+        return screen;
+    }
+
+    void Rasterizer::DrawMesh(Canvas& canvas, const Mesh& mesh, const Matrix4x4& mvpMatrix, Color color, LinearArena& arena) {
+        Vector3* screen = ProjectMesh(canvas, mesh, mvpMatrix, arena);
+        DrawTriangles(canvas, screen, nullptr, mesh.indices.data(), mesh.indices.size(), nullptr, color);
+    }
+
+    void Rasterizer::DrawMesh(Canvas& canvas, const Mesh& mesh, const Matrix4x4& mvpMatrix, const Texture& texture, Color tint, LinearArena& arena) {
+        if (mesh.uvs.size() < mesh.VertexCount()) {
+            DrawMesh(canvas, mesh, mvpMatrix, tint, arena);
+            return;
+        }
+
+        Vector3* screen = ProjectMesh(canvas, mesh, mvpMatrix, arena);
+        TexCoord* uvs = arena.AllocateArray<TexCoord>(mesh.VertexCount());
+        mesh.DecodeUVs(0, mesh.VertexCount(), &uvs[0].u);
+        DrawTriangles(canvas, screen, uvs, mesh.indices.data(), mesh.indices.size(), &texture, tint);
     }
 
     void Rasterizer::DrawLine(Canvas& canvas, Point2D p1, Point2D p2, Color color) {
@@ -80,6 +226,8 @@ namespace Shika {
     }
 
     Vector3 Rasterizer::TransformVertex(const Vector3& vertex, const Matrix4x4& mvpMatrix, int width, int height) {
+            SHIKA_STATS_ADD(verticesTransformed, 1);
+
              // 1. MVP Transform 
             __m128 raw = Matrix4x4::TransformVector(vertex, mvpMatrix);
             alignas(16) float res[4];
@@ -94,8 +242,17 @@ namespace Shika {
             float screenX = (x + 1.0f) * 0.5f * width;
             float screenY = (1.0f - y) * 0.5f * height;
 
-            return Vector3(screenX, screenY, z);
+            // 1 / w : perspective correct attribute interpolation
+            Vector3 screen(screenX, screenY, z);
+            screen.e[3] = w != 0.0f ? 1.0f / w : 1.0f;
+            return screen;
         }
+
+    void Rasterizer::TransformVertices(const Vector3* vertices, Vector3* out, size_t count, const Matrix4x4& mvpMatrix, int width, int height) {
+        SHIKA_STATS_SCOPE(RenderStage::Transform);
+        SHIKA_STATS_ADD(verticesTransformed, count);
+        GetKernels().ProjectVertices(reinterpret_cast<const float*>(vertices), reinterpret_cast<float*>(out), count, mvpMatrix.e, width, height);
+    }
     
 }
 
@@ -0,0 +1,171 @@
+#include "../include/RenderStats.h"
+#include "../include/Canvas.h"
+#include <algorithm>
+#include <mutex>
+#include <sstream>
+
+namespace Shika {
+
+    RenderStats& RenderStats::operator+=(const RenderStats& other) {
+        verticesTransformed     += other.verticesTransformed;
+        trianglesSubmitted      += other.trianglesSubmitted;
+        trianglesCulledBackface += other.trianglesCulledBackface;
+        trianglesCulledFrustum  += other.trianglesCulledFrustum;
+        trianglesCulledZeroArea += other.trianglesCulledZeroArea;
+        trianglesCulledSubPixel += other.trianglesCulledSubPixel;
+        trianglesRasterized     += other.trianglesRasterized;
+        pixelsTested            += other.pixelsTested;
+        pixelsCovered           += other.pixelsCovered;
+        depthPass               += other.depthPass;
+        depthFail               += other.depthFail;
+        for (int i = 0; i < (int)RenderStage::Count; i++) {
+            stageCycles[i] += other.stageCycles[i];
+        }
+        return *this;
+    }
+
+    std::string RenderStats::ToJson() const {
+        std::ostringstream os;
+        os << "{\n"
+           << "  \"verticesTransformed\": " << verticesTransformed << ",\n"
+           << "  \"trianglesSubmitted\": " << trianglesSubmitted << ",\n"
+           << "  \"trianglesCulledBackface\": " << trianglesCulledBackface << ",\n"
+           << "  \"trianglesCulledFrustum\": " << trianglesCulledFrustum << ",\n"
+           << "  \"trianglesCulledZeroArea\": " << trianglesCulledZeroArea << ",\n"
+           << "  \"trianglesCulledSubPixel\": " << trianglesCulledSubPixel << ",\n"
+           << "  \"trianglesRasterized\": " << trianglesRasterized << ",\n"
+           << "  \"pixelsTested\": " << pixelsTested << ",\n"
+           << "  \"pixelsCovered\": " << pixelsCovered << ",\n"
+           << "  \"depthPass\": " << depthPass << ",\n"
+           << "  \"depthFail\": " << depthFail << ",\n"
+           << "  \"pixelsTouched\": " << pixelsTouched << ",\n"
+           << "  \"overdraw\": " << overdraw << ",\n"
+           << "  \"stageCycles\": {";
+        for (int i = 0; i < (int)RenderStage::Count; i++) {
+            os << (i ? ", " : " ") << "\"" << Stats::StageName((RenderStage)i) << "\": " << stageCycles[i];
+        }
+        os << " }\n}";
+        return os.str();
+    }
+
+    namespace Stats {
+        namespace {
+            struct ThreadSlot;
+
+            struct Registry {
+                std::mutex mutex;
+                std::vector<ThreadSlot*> threads;
+                RenderStats retired; // counters of threads that exited during the frame
+
+                // Overdraw target : per-thread counters are summed here (no shared writes while rendering)
+                std::vector<uint32_t> retiredOverdraw;
+                std::vector<uint32_t> overdraw; // sum of the last EndFrame
+                int width = 0;
+                int height = 0;
+            };
+
+            Registry& GetRegistry() {
+                static Registry registry;
+                return registry;
+            }
+
+            // Adds a thread's overdraw counters if they belong to the current target
+            void AddOverdraw(std::vector<uint32_t>& sum, const std::vector<uint16_t>& counts) {
+                if (counts.size() != sum.size()) return;
+                for (size_t i = 0; i < counts.size(); i++) sum[i] += counts[i];
+            }
+
+            // Thread-local counters, merged into the registry when the thread exits
+            struct ThreadSlot {
+                RenderStats stats;
+                std::vector<uint16_t> overdraw; // allocated on the first OverdrawRow of the thread
+
+                ThreadSlot() {
+                    Registry& r = GetRegistry();
+                    std::lock_guard<std::mutex> lock(r.mutex);
+                    r.threads.push_back(this);
+                }
+
+                ~ThreadSlot() {
+                    Registry& r = GetRegistry();
+                    std::lock_guard<std::mutex> lock(r.mutex);
+                    r.retired += stats;
+                    AddOverdraw(r.retiredOverdraw, overdraw);
+                    r.threads.erase(std::find(r.threads.begin(), r.threads.end(), this));
+                }
+            };
+
+            ThreadSlot& Slot() {
+                thread_local ThreadSlot slot;
+                return slot;
+            }
+        }
+
+        RenderStats& Local() {
+            return Slot().stats;
+        }
+
+        void BeginFrame() {
+            Registry& r = GetRegistry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            for (ThreadSlot* t : r.threads) {
+                t->stats = RenderStats();
+                std::fill(t->overdraw.begin(), t->overdraw.end(), (uint16_t)0);
+            }
+            r.retired = RenderStats();
+            std::fill(r.retiredOverdraw.begin(), r.retiredOverdraw.end(), 0u);
+        }
+
+        RenderStats EndFrame() {
+            Registry& r = GetRegistry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+
+            RenderStats total = r.retired;
+            r.overdraw = r.retiredOverdraw;
+            for (const ThreadSlot* t : r.threads) {
+                total += t->stats;
+                AddOverdraw(r.overdraw, t->overdraw);
+            }
+
+            for (uint32_t count : r.overdraw) {
+                if (count) total.pixelsTouched++;
+            }
+            if (total.pixelsTouched) {
+                total.overdraw = (float)total.depthPass / (float)total.pixelsTouched;
+            }
+            return total;
+        }
+
+        void EnableOverdraw(int width, int height) {
+            Registry& r = GetRegistry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            r.width = width;
+            r.height = height;
+            r.retiredOverdraw.assign((size_t)width * height, 0);
+            r.overdraw.assign((size_t)width * height, 0);
+            for (ThreadSlot* t : r.threads) t->overdraw.clear();
+        }
+
+        uint16_t* OverdrawRow(int width, int height, int y) {
+            Registry& r = GetRegistry();
+            if (r.overdraw.empty() || r.width != width || r.height != height) return nullptr;
+            std::vector<uint16_t>& counts = Slot().overdraw;
+            if (counts.size() != r.overdraw.size()) counts.assign(r.overdraw.size(), 0);
+            return counts.data() + (size_t)y * width;
+        }
+
+        void RenderOverdrawHeatmap(Canvas& canvas) {
+            Registry& r = GetRegistry();
+            if (r.overdraw.empty() || r.width != canvas.GetWidth() || r.height != canvas.GetHeight()) return;
+
+            static const Color ramp[5] = {
+                Color::Black(), Color::Blue(), Color::Green(), {1.0f, 1.0f, 0.0f}, Color::Red()
+            };
+
+            Color* pixels = canvas.PixelData();
+            for (size_t i = 0; i < r.overdraw.size(); i++) {
+                pixels[i] = ramp[std::min<uint32_t>(r.overdraw[i], 4)];
+            }
+        }
+    }
+}
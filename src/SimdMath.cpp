@@ -0,0 +1,74 @@
+#include "../include/SimdMath.h"
+#include "../include/Matrix4x4.h"
+#include "../include/Quaternion.h"
+
+namespace Shika {
+
+    // Batches are processed in fixed chunks so the sin/cos scratch stays on the stack
+    static const size_t BatchChunk = 256;
+
+    // --- Matrix4x4 ---
+    template <typename Build>
+    static void RotationBatch(const float* angles, Matrix4x4* out, size_t count, Build build) {
+        alignas(64) float s[BatchChunk];
+        alignas(64) float c[BatchChunk];
+
+        for (size_t first = 0; first < count; first += BatchChunk) {
+            size_t n = count - first < BatchChunk ? count - first : BatchChunk;
+            SimdMath::SinCos(angles + first, s, c, n);
+            for (size_t i = 0; i < n; i++) out[first + i] = build(s[i], c[i]);
+        }
+    }
+
+    void Matrix4x4::RotationXBatch(const float* angles, Matrix4x4* out, size_t count) {
+        RotationBatch(angles, out, count, Matrix4x4::RotationXFromSinCos);
+    }
+
+    void Matrix4x4::RotationYBatch(const float* angles, Matrix4x4* out, size_t count) {
+        RotationBatch(angles, out, count, Matrix4x4::RotationYFromSinCos);
+    }
+
+    void Matrix4x4::RotationZBatch(const float* angles, Matrix4x4* out, size_t count) {
+        RotationBatch(angles, out, count, Matrix4x4::RotationZFromSinCos);
+    }
+
+    // --- Quaternion ---
+    void Quaternion::RotationAxisBatch(const Vector3* axes, const float* angles, Quaternion* out, size_t count) {
+        alignas(64) float half[BatchChunk];
+        alignas(64) float s[BatchChunk];
+        alignas(64) float c[BatchChunk];
+
+        for (size_t first = 0; first < count; first += BatchChunk) {
+            size_t n = count - first < BatchChunk ? count - first : BatchChunk;
+            for (size_t i = 0; i < n; i++) half[i] = angles[first + i] * 0.5f;
+            SimdMath::SinCos(half, s, c, n);
+            for (size_t i = 0; i < n; i++) {
+                out[first + i] = RotationAxisFromSinCos(axes[first + i], s[i], c[i]);
+            }
+        }
+    }
+
+    void Quaternion::RotationYawPitchRollBatch(const float* pitch, const float* yaw, const float* roll, Quaternion* out, size_t count) {
+        // One SinCos call for all three angles : [pitch | yaw | roll]
+        alignas(64) float half[3 * BatchChunk];
+        alignas(64) float s[3 * BatchChunk];
+        alignas(64) float c[3 * BatchChunk];
+
+        for (size_t first = 0; first < count; first += BatchChunk) {
+            size_t n = count - first < BatchChunk ? count - first : BatchChunk;
+            for (size_t i = 0; i < n; i++) {
+                half[i]         = pitch[first + i] * 0.5f;
+                half[n + i]     = yaw[first + i] * 0.5f;
+                half[2 * n + i] = roll[first + i] * 0.5f;
+            }
+            SimdMath::SinCos(half, s, c, 3 * n);
+
+            for (size_t i = 0; i < n; i++) {
+                Quaternion qPitch(s[i], 0, 0, c[i]);
+                Quaternion qYaw(0, s[n + i], 0, c[n + i]);
+                Quaternion qRoll(0, 0, s[2 * n + i], c[2 * n + i]);
+                out[first + i] = qYaw * qPitch * qRoll;
+            }
+        }
+    }
+}
@@ -0,0 +1,217 @@
+#include "../include/Texture.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Shika {
+
+    namespace {
+        const int MaxLevels = 16;
+
+        int NextPow2(int v) {
+            int p = 1;
+            while (p < v) p <<= 1;
+            return p;
+        }
+
+        int Log2(int pow2) {
+            int n = 0;
+            while ((1 << n) < pow2) n++;
+            return n;
+        }
+
+        uint32_t PackRGBA8(const Color& c) {
+            auto channel = [](float v) -> uint32_t {
+                return (uint32_t)(std::clamp(v, 0.0f, 1.0f) * 255.0f + 0.5f);
+            };
+            return channel(c.r) | (channel(c.g) << 8) | (channel(c.b) << 16) | 0xFF000000u;
+        }
+
+        // Spread the low 16 bits to the even bit positions
+        uint32_t Part1By1(uint32_t x) {
+            x &= 0x0000FFFFu;
+            x = (x | (x << 8)) & 0x00FF00FFu;
+            x = (x | (x << 4)) & 0x0F0F0F0Fu;
+            x = (x | (x << 2)) & 0x33333333u;
+            x = (x | (x << 1)) & 0x55555555u;
+            return x;
+        }
+
+        Color Lerp(const Color& a, const Color& b, float t) {
+            return { a.r + (b.r - a.r) * t, a.g + (b.g - a.g) * t, a.b + (b.b - a.b) * t };
+        }
+    }
+
+    Texture::Texture(int w, int h, const std::vector<Color>& colors, TextureLayout textureLayout)
+        : width(std::clamp(w, 1, 32768)), height(std::clamp(h, 1, 32768)), layout(textureLayout) {
+        if (layout == TextureLayout::Auto) {
+            layout = NextPow2(width) == width && NextPow2(height) == height ? TextureLayout::Morton : TextureLayout::RowMajor;
+        }
+        AllocateLevels(1);
+        std::vector<Color> level0(colors);
+        level0.resize((size_t)width * height, Color::Black());
+        StoreLevel(0, level0);
+    }
+
+    Texture Texture::Checkerboard(int size, int checks, Color a, Color b, TextureLayout layout) {
+        std::vector<Color> colors((size_t)size * size);
+        int cell = std::max(1, size / std::max(1, checks));
+        for (int y = 0; y < size; y++) {
+            for (int x = 0; x < size; x++) {
+                colors[(size_t)y * size + x] = ((x / cell + y / cell) & 1) ? b : a;
+            }
+        }
+        return Texture(size, size, colors, layout);
+    }
+
+    void Texture::AllocateLevels(int count) {
+        size_t total = 0;
+        int w = width, h = height;
+        for (int level = 0; level < count; level++) {
+            offset[level] = (int32_t)total;
+            levelWidth[level] = w;
+            levelHeight[level] = h;
+            if (layout == TextureLayout::Morton) {
+                int pw = NextPow2(w), ph = NextPow2(h);
+                mortonMask[level] = (1 << std::min(Log2(pw), Log2(ph))) - 1;
+                total += (size_t)pw * ph;
+            }
+            else {
+                mortonMask[level] = 0;
+                total += (size_t)w * h;
+            }
+            w = std::max(1, w / 2);
+            h = std::max(1, h / 2);
+        }
+        // Unused table entries point at level 0 (the kernels clamp the level anyway)
+        for (int level = count; level < MaxLevels; level++) {
+            offset[level] = offset[0];
+            levelWidth[level] = levelWidth[0];
+            levelHeight[level] = levelHeight[0];
+            mortonMask[level] = mortonMask[0];
+        }
+        levelCount = count;
+        texels.assign(total, 0u);
+    }
+
+    uint32_t Texture::TexelIndex(int level, int x, int y) const {
+        if (layout == TextureLayout::RowMajor) {
+            return (uint32_t)(offset[level] + y * levelWidth[level] + x);
+        }
+        // Morton : low bits interleaved (x even, y odd), the rest of the longer side above them
+        uint32_t mask = (uint32_t)mortonMask[level];
+        uint32_t lx = (uint32_t)x & mask, ly = (uint32_t)y & mask;
+        uint32_t low = Part1By1(lx) | (Part1By1(ly) << 1);
+        uint32_t high = ((uint32_t)x - lx + (uint32_t)y - ly) * (mask + 1);
+        return (uint32_t)offset[level] + low + high;
+    }
+
+    void Texture::StoreLevel(int level, const std::vector<Color>& colors) {
+        int w = levelWidth[level], h = levelHeight[level];
+        for (int y = 0; y < h; y++) {
+            for (int x = 0; x < w; x++) {
+                texels[TexelIndex(level, x, y)] = PackRGBA8(colors[(size_t)y * w + x]);
+            }
+        }
+    }
+
+    void Texture::GenerateMips() {
+        // Filter in float from level 0 (no 8-bit rounding carried down the chain)
+        std::vector<Color> current((size_t)width * height);
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) current[(size_t)y * width + x] = Fetch(0, x, y);
+        }
+
+        int count = 1;
+        for (int size = std::max(width, height); size > 1 && count < MaxLevels; size /= 2) count++;
+
+        AllocateLevels(count);
+        StoreLevel(0, current);
+
+        for (int level = 1; level < count; level++) {
+            int pw = levelWidth[level - 1], ph = levelHeight[level - 1];
+            int w = levelWidth[level], h = levelHeight[level];
+            std::vector<Color> next((size_t)w * h);
+            for (int y = 0; y < h; y++) {
+                int y0 = std::min(2 * y, ph - 1), y1 = std::min(2 * y + 1, ph - 1);
+                for (int x = 0; x < w; x++) {
+                    int x0 = std::min(2 * x, pw - 1), x1 = std::min(2 * x + 1, pw - 1);
+                    const Color& a = current[(size_t)y0 * pw + x0];
+                    const Color& b = current[(size_t)y0 * pw + x1];
+                    const Color& c = current[(size_t)y1 * pw + x0];
+                    const Color& d = current[(size_t)y1 * pw + x1];
+                    next[(size_t)y * w + x] = { (a.r + b.r + c.r + d.r) * 0.25f,
+                                                (a.g + b.g + c.g + d.g) * 0.25f,
+                                                (a.b + b.b + c.b + d.b) * 0.25f };
+                }
+            }
+            StoreLevel(level, next);
+            current.swap(next);
+        }
+    }
+
+    Color Texture::Fetch(int level, int x, int y) const {
+        uint32_t t = texels[TexelIndex(level, x, y)];
+        const float scale = 1.0f / 255.0f;
+        return { (float)(t & 0xFF) * scale, (float)((t >> 8) & 0xFF) * scale, (float)((t >> 16) & 0xFF) * scale };
+    }
+
+    // --- Scalar Reference (TextureImpl.inl) ---
+    int Texture::WrapCoord(float c, int size) const {
+        float fsize = (float)size;
+        if (wrap == TextureWrap::Repeat) {
+            c = c - fsize * std::floor(c / fsize);
+            if (c < 0.0f) c += fsize;
+            if (!(c < fsize)) c -= fsize;
+        }
+        if (!(c >= 0.0f)) return 0; // also NaN
+        return (int)std::min(c, fsize - 1.0f);
+    }
+
+    Color Texture::SampleBilinear(int level, float u, float v) const {
+        float fx = u * (float)levelWidth[level] - 0.5f;
+        float fy = v * (float)levelHeight[level] - 0.5f;
+        float x0 = std::floor(fx), y0 = std::floor(fy);
+        float ax = fx - x0, ay = fy - y0;
+
+        int ix0 = WrapCoord(x0, levelWidth[level]), ix1 = WrapCoord(x0 + 1.0f, levelWidth[level]);
+        int iy0 = WrapCoord(y0, levelHeight[level]), iy1 = WrapCoord(y0 + 1.0f, levelHeight[level]);
+        Color top = Lerp(Fetch(level, ix0, iy0), Fetch(level, ix1, iy0), ax);
+        Color bottom = Lerp(Fetch(level, ix0, iy1), Fetch(level, ix1, iy1), ax);
+        return Lerp(top, bottom, ay);
+    }
+
+    Color Texture::Sample(float u, float v, float lod) const {
+        if (filter == TextureFilter::Nearest) {
+            int x = WrapCoord(std::floor(u * (float)width), width);
+            int y = WrapCoord(std::floor(v * (float)height), height);
+            return Fetch(0, x, y);
+        }
+
+        float maxLevel = (float)(levelCount - 1);
+        lod = std::min(lod > 0.0f ? lod : 0.0f, maxLevel);
+
+        if (filter == TextureFilter::Bilinear) {
+            return SampleBilinear((int)std::floor(lod + 0.5f), u, v);
+        }
+
+        float base = std::floor(lod);
+        float next = std::min(base + 1.0f, maxLevel);
+        return Lerp(SampleBilinear((int)base, u, v), SampleBilinear((int)next, u, v), lod - base);
+    }
+
+    TextureView Texture::View() const {
+        TextureView view;
+        view.texels = texels.data();
+        view.levelCount = levelCount;
+        view.layout = (int32_t)layout;
+        view.filter = (int32_t)filter;
+        view.wrap = (int32_t)wrap;
+        for (int i = 0; i < MaxLevels; i++) {
+            view.offset[i] = offset[i];
+            view.width[i] = levelWidth[i];
+            view.height[i] = levelHeight[i];
+            view.mortonMask[i] = mortonMask[i];
+        }
+        return view;
+    }
+}
@@ -0,0 +1,191 @@
+// Shared BVH traversal kernels (Bvh.h).
+// Included by every Kernels_*.cpp inside its anonymous namespace, after the 8-lane wrapper
+// `Lane8` (F : 8 floats, comparisons return F masks, MaskBits -> 8 bits) is defined.
+// One ray at a time, all 8 children (or 8 triangles) of a node per step.
+
+// Each BVH8 level pops 1 entry & pushes at most 8 : depth <= BvhMaxDepth (asserted by Bvh::Build)
+const int BvhStackSize = 1024;
+static_assert(7 * BvhMaxDepth + 1 <= BvhStackSize, "BVH traversal stack too small for BvhMaxDepth");
+
+struct BvhStackEntry {
+    int32_t ref;  // >= 0 : node, < 0 : leaf
+    float tNear;  // entry distance of the box
+};
+
+// Per-ray constants broadcast to 8 lanes
+struct RayLanes {
+    Lane8::F ox, oy, oz;
+    Lane8::F dx, dy, dz;
+    Lane8::F ix, iy, iz;    // 1 / d
+    Lane8::F oix, oiy, oiz; // o / d
+    bool negX, negY, negZ;  // near plane is max for negative directions
+};
+
+// 1 / d without infinities (0 * inf = NaN in the slab test)
+inline float SafeInverse(float d) {
+    const float tiny = 1e-30f;
+    float a = d < 0.0f ? -d : d;
+    if (a < tiny) d = d < 0.0f ? -tiny : tiny;
+    return 1.0f / d;
+}
+
+inline void SetupRay(const BvhRay& ray, RayLanes& l) {
+    float ix = SafeInverse(ray.dx), iy = SafeInverse(ray.dy), iz = SafeInverse(ray.dz);
+    l.ox = Lane8::Set(ray.ox); l.oy = Lane8::Set(ray.oy); l.oz = Lane8::Set(ray.oz);
+    l.dx = Lane8::Set(ray.dx); l.dy = Lane8::Set(ray.dy); l.dz = Lane8::Set(ray.dz);
+    l.ix = Lane8::Set(ix); l.iy = Lane8::Set(iy); l.iz = Lane8::Set(iz);
+    l.oix = Lane8::Set(ray.ox * ix); l.oiy = Lane8::Set(ray.oy * iy); l.oiz = Lane8::Set(ray.oz * iz);
+    l.negX = ix < 0.0f; l.negY = iy < 0.0f; l.negZ = iz < 0.0f;
+}
+
+// --- Ray vs 8 Boxes (slab test) ---
+// Empty child slots (min = +inf, max = -inf) always miss
+// Return : bits of the children hit in [tMin, tMax], entry distances in tNear
+inline unsigned int IntersectNode(const BvhNode8& n, const RayLanes& l, float tMin, float tMax, float* tNear) {
+    Lane8::F x0 = Lane8::MulSub(Lane8::Load(l.negX ? n.maxX : n.minX), l.ix, l.oix);
+    Lane8::F y0 = Lane8::MulSub(Lane8::Load(l.negY ? n.maxY : n.minY), l.iy, l.oiy);
+    Lane8::F z0 = Lane8::MulSub(Lane8::Load(l.negZ ? n.maxZ : n.minZ), l.iz, l.oiz);
+    Lane8::F x1 = Lane8::MulSub(Lane8::Load(l.negX ? n.minX : n.maxX), l.ix, l.oix);
+    Lane8::F y1 = Lane8::MulSub(Lane8::Load(l.negY ? n.minY : n.maxY), l.iy, l.oiy);
+    Lane8::F z1 = Lane8::MulSub(Lane8::Load(l.negZ ? n.minZ : n.maxZ), l.iz, l.oiz);
+
+    Lane8::F enter = Lane8::Max(Lane8::Max(x0, y0), Lane8::Max(z0, Lane8::Set(tMin)));
+    Lane8::F exit = Lane8::Min(Lane8::Min(x1, y1), Lane8::Min(z1, Lane8::Set(tMax)));
+    // Conservative : covers the rounding of the slab distances
+    exit = Lane8::Mul(exit, Lane8::Set(1.0000004f));
+
+    Lane8::Store(tNear, enter);
+    return Lane8::MaskBits(Lane8::Le(enter, exit));
+}
+
+// --- Ray vs 8 Triangles (Moller-Trumbore, SoA) ---
+// Return : bits of the triangles hit in (tMin, tMax), t/u/v per lane
+inline unsigned int IntersectLeaf(const BvhTriangles8& b, const RayLanes& l, float tMin, float tMax, float* t, float* u, float* v) {
+    Lane8::F e1x = Lane8::Load(b.e1x), e1y = Lane8::Load(b.e1y), e1z = Lane8::Load(b.e1z);
+    Lane8::F e2x = Lane8::Load(b.e2x), e2y = Lane8::Load(b.e2y), e2z = Lane8::Load(b.e2z);
+
+    // p = d x e2
+    Lane8::F px = Lane8::MulSub(l.dy, e2z, Lane8::Mul(l.dz, e2y));
+    Lane8::F py = Lane8::MulSub(l.dz, e2x, Lane8::Mul(l.dx, e2z));
+    Lane8::F pz = Lane8::MulSub(l.dx, e2y, Lane8::Mul(l.dy, e2x));
+    Lane8::F det = Lane8::MulAdd(e1x, px, Lane8::MulAdd(e1y, py, Lane8::Mul(e1z, pz)));
+    Lane8::F invDet = Lane8::Div(Lane8::Set(1.0f), det);
+
+    // s = o - v0
+    Lane8::F sx = Lane8::Sub(l.ox, Lane8::Load(b.v0x));
+    Lane8::F sy = Lane8::Sub(l.oy, Lane8::Load(b.v0y));
+    Lane8::F sz = Lane8::Sub(l.oz, Lane8::Load(b.v0z));
+    Lane8::F bu = Lane8::Mul(Lane8::MulAdd(sx, px, Lane8::MulAdd(sy, py, Lane8::Mul(sz, pz))), invDet);
+
+    // q = s x e1
+    Lane8::F qx = Lane8::MulSub(sy, e1z, Lane8::Mul(sz, e1y));
+    Lane8::F qy = Lane8::MulSub(sz, e1x, Lane8::Mul(sx, e1z));
+    Lane8::F qz = Lane8::MulSub(sx, e1y, Lane8::Mul(sy, e1x));
+    Lane8::F bv = Lane8::Mul(Lane8::MulAdd(l.dx, qx, Lane8::MulAdd(l.dy, qy, Lane8::Mul(l.dz, qz))), invDet);
+    Lane8::F bt = Lane8::Mul(Lane8::MulAdd(e2x, qx, Lane8::MulAdd(e2y, qy, Lane8::Mul(e2z, qz))), invDet);
+
+    // Degenerate / padding lanes : det = 0 (NaN / inf barycentrics fail the tests anyway)
+    Lane8::F zero = Lane8::Set(0.0f);
+    Lane8::F hit = Lane8::Neq(det, zero);
+    hit = Lane8::And(hit, Lane8::Ge(bu, zero));
+    hit = Lane8::And(hit, Lane8::Ge(bv, zero));
+    hit = Lane8::And(hit, Lane8::Le(Lane8::Add(bu, bv), Lane8::Set(1.0f)));
+    hit = Lane8::And(hit, Lane8::Gt(bt, Lane8::Set(tMin)));
+    hit = Lane8::And(hit, Lane8::Lt(bt, Lane8::Set(tMax)));
+
+    Lane8::Store(t, bt);
+    Lane8::Store(u, bu);
+    Lane8::Store(v, bv);
+    return Lane8::MaskBits(hit);
+}
+
+// Push the hit children, farthest first (the nearest is popped next)
+inline int PushChildren(const BvhNode8& node, unsigned int bits, const float* tNear, BvhStackEntry* stack, int sp) {
+    int first = sp;
+    for (; bits; bits &= bits - 1) {
+        int i = LowestBit(bits);
+        BvhStackEntry e = { node.child[i], tNear[i] };
+        int j = sp++;
+        while (j > first && stack[j - 1].tNear < e.tNear) {
+            stack[j] = stack[j - 1];
+            j--;
+        }
+        stack[j] = e;
+    }
+    return sp;
+}
+
+// --- Closest Hit ---
+inline void IntersectRay(const BvhView& bvh, const BvhRay& ray, BvhHit& hit) {
+    hit.t = ray.tMax;
+    hit.u = 0.0f;
+    hit.v = 0.0f;
+    hit.triangle = -1;
+    if (bvh.nodeCount == 0) return;
+
+    RayLanes l;
+    SetupRay(ray, l);
+
+    BvhStackEntry stack[BvhStackSize];
+    int sp = 0;
+    stack[sp++] = { 0, ray.tMin };
+
+    alignas(32) float tNear[8], t[8], u[8], v[8];
+    while (sp > 0) {
+        BvhStackEntry e = stack[--sp];
+        if (e.tNear > hit.t) continue;
+
+        if (e.ref < 0) {
+            const BvhTriangles8& leaf = bvh.leaves[~e.ref];
+            unsigned int bits = IntersectLeaf(leaf, l, ray.tMin, hit.t, t, u, v);
+            for (; bits; bits &= bits - 1) {
+                int i = LowestBit(bits);
+                if (t[i] < hit.t) {
+                    hit.t = t[i];
+                    hit.u = u[i];
+                    hit.v = v[i];
+                    hit.triangle = leaf.triangle[i];
+                }
+            }
+            continue;
+        }
+
+        const BvhNode8& node = bvh.nodes[e.ref];
+        unsigned int bits = IntersectNode(node, l, ray.tMin, hit.t, tNear);
+        sp = PushChildren(node, bits, tNear, stack, sp);
+    }
+}
+
+// --- Any Hit ---
+inline bool OccludedRay(const BvhView& bvh, const BvhRay& ray) {
+    if (bvh.nodeCount == 0) return false;
+
+    RayLanes l;
+    SetupRay(ray, l);
+
+    int32_t stack[BvhStackSize];
+    int sp = 0;
+    stack[sp++] = 0;
+
+    alignas(32) float tNear[8], t[8], u[8], v[8];
+    while (sp > 0) {
+        int32_t ref = stack[--sp];
+        if (ref < 0) {
+            if (IntersectLeaf(bvh.leaves[~ref], l, ray.tMin, ray.tMax, t, u, v) != 0) return true;
+            continue;
+        }
+
+        const BvhNode8& node = bvh.nodes[ref];
+        unsigned int bits = IntersectNode(node, l, ray.tMin, ray.tMax, tNear);
+        for (; bits; bits &= bits - 1) stack[sp++] = node.child[LowestBit(bits)];
+    }
+    return false;
+}
+
+void IntersectRays(const BvhView& bvh, const BvhRay* rays, BvhHit* hits, size_t count) {
+    for (size_t i = 0; i < count; i++) IntersectRay(bvh, rays[i], hits[i]);
+}
+
+void OccludedRays(const BvhView& bvh, const BvhRay* rays, uint8_t* occluded, size_t count) {
+    for (size_t i = 0; i < count; i++) occluded[i] = OccludedRay(bvh, rays[i]) ? 1 : 0;
+}
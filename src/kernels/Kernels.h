@@ -0,0 +1,64 @@
+#pragma once
+
+// Internal : per-ISA kernel tables.
+// Each Kernels_*.cpp is compiled with its own -m flags, so these translation units
+// must not include the inline math headers (Vector3.h, Matrix4x4.h ...) or use STL templates.
+// Otherwise the linker may keep an AVX copy of a shared inline function and run it on an older CPU.
+
+#include "../../include/CpuDispatch.h"
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+namespace Shika {
+    namespace Kernels {
+        extern const KernelTable TableSSE41;
+        extern const KernelTable TableAVX2;
+        extern const KernelTable TableAVX512;
+    }
+}
+
+namespace Shika {
+    namespace Kernels {
+        // Index of the lowest set bit (bits != 0)
+        static inline int LowestBit(unsigned int bits) {
+        #if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward(&index, bits);
+            return (int)index;
+        #else
+            return __builtin_ctz(bits);
+        #endif
+        }
+
+        static inline int PopCount(unsigned int bits) {
+            int count = 0;
+            for (; bits; bits &= bits - 1) count++;
+            return count;
+        }
+
+        // Coverage & overdraw counters of one chunk (offset : first pixel of the chunk in the span)
+        static inline void CountRasterChunk(RasterRowStats* stats, int offset, unsigned int insideBits, unsigned int passBits) {
+            stats->covered += (uint32_t)PopCount(insideBits);
+            if (stats->overdrawRow == nullptr) return;
+            for (; passBits; passBits &= passBits - 1) {
+                uint16_t& count = stats->overdrawRow[offset + LowestBit(passBits)];
+                if (count != 0xFFFF) count++; // saturating
+            }
+        }
+
+        // Write the flat color to every pixel set in the coverage mask
+        // Return : the number of pixels written
+        static inline int WriteMaskedColor(float* rgb, unsigned int bits, const float* color) {
+            int written = 0;
+            while (bits) {
+                float* p = rgb + 3 * LowestBit(bits);
+                p[0] = color[0]; p[1] = color[1]; p[2] = color[2];
+                bits &= bits - 1;
+                written++;
+            }
+            return written;
+        }
+    }
+}
@@ -0,0 +1,255 @@
+// AVX2 + FMA kernels (8-wide)
+#include "Kernels.h"
+#include <immintrin.h>
+
+namespace Shika {
+    namespace Kernels {
+        namespace {
+
+            // Two points per register : [x0 y0 z0 w0 | x1 y1 z1 w1]
+            inline __m256 TransformRow2(__m256 p, const __m256* rows) {
+                __m256 x = _mm256_permute_ps(p, _MM_SHUFFLE(0, 0, 0, 0));
+                __m256 y = _mm256_permute_ps(p, _MM_SHUFFLE(1, 1, 1, 1));
+                __m256 z = _mm256_permute_ps(p, _MM_SHUFFLE(2, 2, 2, 2));
+
+                __m256 r = _mm256_fmadd_ps(x, rows[0], rows[3]);
+                r = _mm256_fmadd_ps(y, rows[1], r);
+                return _mm256_fmadd_ps(z, rows[2], r);
+            }
+
+            inline void LoadRows(const float* mat, __m256* rows) {
+                rows[0] = _mm256_broadcast_ps((const __m128*)(mat + 0));
+                rows[1] = _mm256_broadcast_ps((const __m128*)(mat + 4));
+                rows[2] = _mm256_broadcast_ps((const __m128*)(mat + 8));
+                rows[3] = _mm256_broadcast_ps((const __m128*)(mat + 12));
+            }
+
+            void TransformPoints(const float* in, float* out, size_t count, const float* mat) {
+                __m256 rows[4];
+                LoadRows(mat, rows);
+
+                size_t i = 0;
+                for (; i + 2 <= count; i += 2) {
+                    _mm256_storeu_ps(out + 4 * i, TransformRow2(_mm256_loadu_ps(in + 4 * i), rows));
+                }
+                if (i < count) {
+                    __m256 r = TransformRow2(_mm256_castps128_ps256(_mm_loadu_ps(in + 4 * i)), rows);
+                    _mm_storeu_ps(out + 4 * i, _mm256_castps256_ps128(r));
+                }
+            }
+
+            inline __m256 Project2(__m256 p, const __m256* rows, __m256 sign, __m256 bias, __m256 scale) {
+                const __m256 one = _mm256_set1_ps(1.0f);
+                __m256 r = TransformRow2(p, rows);
+
+                // Perspective Divide (skipped if w == 0)
+                __m256 w = _mm256_permute_ps(r, _MM_SHUFFLE(3, 3, 3, 3));
+                w = _mm256_blendv_ps(w, one, _mm256_cmp_ps(w, _mm256_setzero_ps(), _CMP_EQ_OQ));
+                __m256 ndc = _mm256_div_ps(r, w);
+
+                // Viewport, 1 / w in the pad lane
+                __m256 s = _mm256_mul_ps(_mm256_fmadd_ps(ndc, sign, bias), scale);
+                return _mm256_blend_ps(s, _mm256_div_ps(one, w), 0x88);
+            }
+
+            void ProjectVertices(const float* in, float* out, size_t count, const float* mvp, int width, int height) {
+                __m256 rows[4];
+                LoadRows(mvp, rows);
+
+                const __m256 sign  = _mm256_setr_ps(1.0f, -1.0f, 1.0f, 0.0f, 1.0f, -1.0f, 1.0f, 0.0f);
+                const __m256 bias  = _mm256_setr_ps(1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f);
+                const float sx = 0.5f * width, sy = 0.5f * height;
+                const __m256 scale = _mm256_setr_ps(sx, sy, 1.0f, 0.0f, sx, sy, 1.0f, 0.0f);
+
+                size_t i = 0;
+                for (; i + 2 <= count; i += 2) {
+                    _mm256_storeu_ps(out + 4 * i, Project2(_mm256_loadu_ps(in + 4 * i), rows, sign, bias, scale));
+                }
+                if (i < count) {
+                    // Upper half is a zero vector : w == 0 is handled by the divide guard
+                    __m256 r = Project2(_mm256_castps128_ps256(_mm_loadu_ps(in + 4 * i)), rows, sign, bias, scale);
+                    _mm_storeu_ps(out + 4 * i, _mm256_castps256_ps128(r));
+                }
+            }
+
+            int RasterRow(const RasterRowSetup& setup, int count, float* depthRow, float* rgbRow, const float* color, RasterRowStats* stats) {
+                const __m256 lane = _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7);
+                const __m256 zero = _mm256_setzero_ps();
+                const __m256 w0 = _mm256_set1_ps(setup.w0), dw0 = _mm256_set1_ps(setup.dw0);
+                const __m256 w1 = _mm256_set1_ps(setup.w1), dw1 = _mm256_set1_ps(setup.dw1);
+                const __m256 w2 = _mm256_set1_ps(setup.w2), dw2 = _mm256_set1_ps(setup.dw2);
+                const __m256 z0 = _mm256_set1_ps(setup.z),  dz  = _mm256_set1_ps(setup.dz);
+                const __m256 fcount = _mm256_set1_ps((float)count);
+
+                int written = 0;
+                for (int i = 0; i < count; i += 8) {
+                    __m256 fi = _mm256_add_ps(_mm256_set1_ps((float)i), lane);
+
+                    // Edge Test (all three edges <= 0), lanes past the span end are masked out
+                    // Unfused mul + add : pixels exactly on an edge are owned the same way at every level
+                    __m256 e0 = _mm256_add_ps(_mm256_mul_ps(fi, dw0), w0);
+                    __m256 e1 = _mm256_add_ps(_mm256_mul_ps(fi, dw1), w1);
+                    __m256 e2 = _mm256_add_ps(_mm256_mul_ps(fi, dw2), w2);
+                    __m256 inside = _mm256_and_ps(_mm256_cmp_ps(e0, zero, _CMP_LE_OQ),
+                                    _mm256_and_ps(_mm256_cmp_ps(e1, zero, _CMP_LE_OQ), _mm256_cmp_ps(e2, zero, _CMP_LE_OQ)));
+                    inside = _mm256_and_ps(inside, _mm256_cmp_ps(fi, fcount, _CMP_LT_OQ));
+                    if (_mm256_movemask_ps(inside) == 0) continue;
+
+                    // Depth Test
+                    __m256i valid = _mm256_castps_si256(inside);
+                    __m256 z = _mm256_add_ps(_mm256_mul_ps(fi, dz), z0);
+                    __m256 depth = _mm256_maskload_ps(depthRow + i, valid);
+                    __m256 pass = _mm256_and_ps(inside, _mm256_cmp_ps(z, depth, _CMP_LT_OQ));
+
+                    unsigned int bits = (unsigned int)_mm256_movemask_ps(pass);
+                    if (stats) CountRasterChunk(stats, i, (unsigned int)_mm256_movemask_ps(inside), bits);
+                    if (bits == 0) continue;
+
+                    _mm256_maskstore_ps(depthRow + i, _mm256_castps_si256(pass), z);
+                    written += WriteMaskedColor(rgbRow + 3 * i, bits, color);
+                }
+                return written;
+            }
+
+            inline __m256i ToInt255(__m256 v) {
+                const __m256 zero = _mm256_setzero_ps();
+                const __m256 one = _mm256_set1_ps(1.0f);
+                const __m256 scale = _mm256_set1_ps(255.99f);
+                return _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(v, zero), one), scale));
+            }
+
+            void ConvertRGB8(const float* in, uint8_t* out, size_t count) {
+                // packs/packus work per 128-bit lane, this restores the dword order afterwards
+                const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+                size_t n = count * 3;
+                size_t i = 0;
+                for (; i + 32 <= n; i += 32) {
+                    __m256i a = ToInt255(_mm256_loadu_ps(in + i + 0));
+                    __m256i b = ToInt255(_mm256_loadu_ps(in + i + 8));
+                    __m256i c = ToInt255(_mm256_loadu_ps(in + i + 16));
+                    __m256i d = ToInt255(_mm256_loadu_ps(in + i + 24));
+                    __m256i packed = _mm256_packus_epi16(_mm256_packs_epi32(a, b), _mm256_packs_epi32(c, d));
+                    _mm256_storeu_si256((__m256i*)(out + i), _mm256_permutevar8x32_epi32(packed, order));
+                }
+                for (; i < n; i++) {
+                    float v = in[i];
+                    v = v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v);
+                    out[i] = (uint8_t)(int)(v * 255.99f);
+                }
+            }
+
+            // --- Compact Vertex Decode ---
+            // [x0 y0 z0 x1 | y1 z1 ..] -> [x0 y0 z0 0 | x1 y1 z1 0]
+            inline __m256 SpreadFloat3x2(__m256 v) {
+                const __m256i spread = _mm256_setr_epi32(0, 1, 2, 2, 3, 4, 5, 5);
+                return _mm256_blend_ps(_mm256_permutevar8x32_ps(v, spread), _mm256_setzero_ps(), 0x88);
+            }
+
+            void DecodeFloat3(const float* in, float* out, size_t count) {
+                size_t i = 0;
+                // 8-float load covers 2 vertices + 2 floats of the third
+                for (; i + 3 <= count; i += 2) {
+                    _mm256_storeu_ps(out + 4 * i, SpreadFloat3x2(_mm256_loadu_ps(in + 3 * i)));
+                }
+                for (; i < count; i += 2) {
+                    size_t n = (count - i) < 2 ? 1 : 2;
+                    float tmpIn[8] = {};
+                    float tmpOut[8];
+                    for (size_t j = 0; j < 3 * n; j++) tmpIn[j] = in[3 * i + j];
+                    _mm256_storeu_ps(tmpOut, SpreadFloat3x2(_mm256_loadu_ps(tmpIn)));
+                    for (size_t j = 0; j < 4 * n; j++) out[4 * i + j] = tmpOut[j];
+                }
+            }
+
+            void DecodeHalf(const uint16_t* in, float* out, size_t count) {
+                size_t i = 0;
+                for (; i + 8 <= count; i += 8) {
+                    _mm256_storeu_ps(out + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(in + i))));
+                }
+                if (i < count) {
+                    uint16_t tmpIn[8] = {};
+                    float tmpOut[8];
+                    for (size_t j = 0; j < count - i; j++) tmpIn[j] = in[i + j];
+                    _mm256_storeu_ps(tmpOut, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)tmpIn)));
+                    for (size_t j = 0; j < count - i; j++) out[i + j] = tmpOut[j];
+                }
+            }
+
+            void DecodeHalf3(const uint16_t* in, float* out, size_t count) {
+                size_t i = 0;
+                // 8-half load covers 2 vertices + 2 halfs of the third
+                for (; i + 3 <= count; i += 2) {
+                    __m256 v = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(in + 3 * i)));
+                    _mm256_storeu_ps(out + 4 * i, SpreadFloat3x2(v));
+                }
+                for (; i < count; i += 2) {
+                    size_t n = (count - i) < 2 ? 1 : 2;
+                    uint16_t tmpIn[8] = {};
+                    float tmpOut[8];
+                    for (size_t j = 0; j < 3 * n; j++) tmpIn[j] = in[3 * i + j];
+                    __m256 v = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)tmpIn));
+                    _mm256_storeu_ps(tmpOut, SpreadFloat3x2(v));
+                    for (size_t j = 0; j < 4 * n; j++) out[4 * i + j] = tmpOut[j];
+                }
+            }
+
+            // 2 packed normals (low 64 bits) -> [x0 y0 z0 0 | x1 y1 z1 0]
+            inline __m256 DecodeNormal2(__m128i two) {
+                const __m256i broadcast = _mm256_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1);
+                // Move each 10-bit field to the top (shift >= 32 clears the w lane), then sign extend
+                const __m256i fieldShift = _mm256_setr_epi32(22, 12, 2, 32, 22, 12, 2, 32);
+
+                __m256i bits = _mm256_permutevar8x32_epi32(_mm256_castsi128_si256(two), broadcast);
+                bits = _mm256_srai_epi32(_mm256_sllv_epi32(bits, fieldShift), 22);
+                __m256 v = _mm256_mul_ps(_mm256_cvtepi32_ps(bits), _mm256_set1_ps(1.0f / 511.0f));
+                return _mm256_max_ps(v, _mm256_set1_ps(-1.0f));
+            }
+
+            void DecodeNormals(const uint32_t* in, float* out, size_t count) {
+                size_t i = 0;
+                for (; i + 2 <= count; i += 2) {
+                    _mm256_storeu_ps(out + 4 * i, DecodeNormal2(_mm_loadl_epi64((const __m128i*)(in + i))));
+                }
+                if (i < count) {
+                    __m256 v = DecodeNormal2(_mm_cvtsi32_si128((int)in[i]));
+                    _mm_storeu_ps(out + 4 * i, _mm256_castps256_ps128(v));
+                }
+            }
+
+            // --- SIMD Math, Texture Sampling, BVH & Triangle Setup : one 8-wide wrapper ---
+            #include "SimdAvx8.inl"
+            using Simd = SimdAvx8;
+            using Lane8 = SimdAvx8;
+
+            #include "SimdMathImpl.inl"
+            #include "TextureImpl.inl"
+
+            #include "BvhTraverseImpl.inl"
+            #include "TriangleSetupImpl.inl"
+        }
+
+        const KernelTable TableAVX2 = {
+            SimdLevel::AVX2,
+            TransformPoints,
+            ProjectVertices,
+            SetupTriangles,
+            RasterRow,
+            RasterRowTextured,
+            SampleTexture,
+            ConvertRGB8,
+            DecodeFloat3,
+            DecodeHalf3,
+            DecodeNormals,
+            DecodeHalf,
+            SinCos,
+            Tan,
+            Atan2,
+            Acos,
+            Exp,
+            Rsqrt,
+            IntersectRays,
+            OccludedRays
+        };
+    }
+}
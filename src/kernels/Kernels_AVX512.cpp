@@ -0,0 +1,293 @@
+// AVX-512F kernels (16-wide)
+#include "Kernels.h"
+#include <immintrin.h>
+
+namespace Shika {
+    namespace Kernels {
+        namespace {
+
+            // Four points per register : [x0 y0 z0 w0 | x1 .. | x2 .. | x3 ..]
+            inline __m512 TransformRow4(__m512 p, const __m512* rows) {
+                __m512 x = _mm512_permute_ps(p, _MM_SHUFFLE(0, 0, 0, 0));
+                __m512 y = _mm512_permute_ps(p, _MM_SHUFFLE(1, 1, 1, 1));
+                __m512 z = _mm512_permute_ps(p, _MM_SHUFFLE(2, 2, 2, 2));
+
+                __m512 r = _mm512_fmadd_ps(x, rows[0], rows[3]);
+                r = _mm512_fmadd_ps(y, rows[1], r);
+                return _mm512_fmadd_ps(z, rows[2], r);
+            }
+
+            inline void LoadRows(const float* mat, __m512* rows) {
+                rows[0] = _mm512_broadcast_f32x4(_mm_loadu_ps(mat + 0));
+                rows[1] = _mm512_broadcast_f32x4(_mm_loadu_ps(mat + 4));
+                rows[2] = _mm512_broadcast_f32x4(_mm_loadu_ps(mat + 8));
+                rows[3] = _mm512_broadcast_f32x4(_mm_loadu_ps(mat + 12));
+            }
+
+            // Load/store mask of the remaining (< 4) points
+            inline __mmask16 TailMask(size_t points) {
+                return (__mmask16)((1u << (4 * points)) - 1u);
+            }
+
+            void TransformPoints(const float* in, float* out, size_t count, const float* mat) {
+                __m512 rows[4];
+                LoadRows(mat, rows);
+
+                size_t i = 0;
+                for (; i + 4 <= count; i += 4) {
+                    _mm512_storeu_ps(out + 4 * i, TransformRow4(_mm512_loadu_ps(in + 4 * i), rows));
+                }
+                if (i < count) {
+                    __mmask16 m = TailMask(count - i);
+                    __m512 r = TransformRow4(_mm512_maskz_loadu_ps(m, in + 4 * i), rows);
+                    _mm512_mask_storeu_ps(out + 4 * i, m, r);
+                }
+            }
+
+            inline __m512 Project4(__m512 p, const __m512* rows, __m512 sign, __m512 bias, __m512 scale) {
+                __m512 r = TransformRow4(p, rows);
+
+                // Perspective Divide (skipped if w == 0)
+                __m512 w = _mm512_permute_ps(r, _MM_SHUFFLE(3, 3, 3, 3));
+                __mmask16 zeroW = _mm512_cmp_ps_mask(w, _mm512_setzero_ps(), _CMP_EQ_OQ);
+                w = _mm512_mask_mov_ps(w, zeroW, _mm512_set1_ps(1.0f));
+                __m512 ndc = _mm512_div_ps(r, w);
+
+                // Viewport, 1 / w in the pad lane
+                __m512 s = _mm512_mul_ps(_mm512_fmadd_ps(ndc, sign, bias), scale);
+                return _mm512_mask_mov_ps(s, 0x8888, _mm512_div_ps(_mm512_set1_ps(1.0f), w));
+            }
+
+            void ProjectVertices(const float* in, float* out, size_t count, const float* mvp, int width, int height) {
+                __m512 rows[4];
+                LoadRows(mvp, rows);
+
+                const __m512 sign  = _mm512_broadcast_f32x4(_mm_setr_ps(1.0f, -1.0f, 1.0f, 0.0f));
+                const __m512 bias  = _mm512_broadcast_f32x4(_mm_setr_ps(1.0f, 1.0f, 0.0f, 0.0f));
+                const __m512 scale = _mm512_broadcast_f32x4(_mm_setr_ps(0.5f * width, 0.5f * height, 1.0f, 0.0f));
+
+                size_t i = 0;
+                for (; i + 4 <= count; i += 4) {
+                    _mm512_storeu_ps(out + 4 * i, Project4(_mm512_loadu_ps(in + 4 * i), rows, sign, bias, scale));
+                }
+                if (i < count) {
+                    __mmask16 m = TailMask(count - i);
+                    __m512 r = Project4(_mm512_maskz_loadu_ps(m, in + 4 * i), rows, sign, bias, scale);
+                    _mm512_mask_storeu_ps(out + 4 * i, m, r);
+                }
+            }
+
+            int RasterRow(const RasterRowSetup& setup, int count, float* depthRow, float* rgbRow, const float* color, RasterRowStats* stats) {
+                const __m512 lane = _mm512_setr_ps(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+                const __m512 zero = _mm512_setzero_ps();
+                const __m512 w0 = _mm512_set1_ps(setup.w0), dw0 = _mm512_set1_ps(setup.dw0);
+                const __m512 w1 = _mm512_set1_ps(setup.w1), dw1 = _mm512_set1_ps(setup.dw1);
+                const __m512 w2 = _mm512_set1_ps(setup.w2), dw2 = _mm512_set1_ps(setup.dw2);
+                const __m512 z0 = _mm512_set1_ps(setup.z),  dz  = _mm512_set1_ps(setup.dz);
+
+                int written = 0;
+                for (int i = 0; i < count; i += 16) {
+                    int remain = count - i;
+                    __mmask16 valid = remain >= 16 ? (__mmask16)0xFFFF : (__mmask16)((1u << remain) - 1u);
+                    __m512 fi = _mm512_add_ps(_mm512_set1_ps((float)i), lane);
+
+                    // Edge Test (all three edges <= 0)
+                    // Unfused mul + add : pixels exactly on an edge are owned the same way at every level
+                    __mmask16 inside = _mm512_mask_cmp_ps_mask(valid, _mm512_add_ps(_mm512_mul_ps(fi, dw0), w0), zero, _CMP_LE_OQ);
+                    inside = _mm512_mask_cmp_ps_mask(inside, _mm512_add_ps(_mm512_mul_ps(fi, dw1), w1), zero, _CMP_LE_OQ);
+                    inside = _mm512_mask_cmp_ps_mask(inside, _mm512_add_ps(_mm512_mul_ps(fi, dw2), w2), zero, _CMP_LE_OQ);
+                    if (inside == 0) continue;
+
+                    // Depth Test
+                    __m512 z = _mm512_add_ps(_mm512_mul_ps(fi, dz), z0);
+                    __m512 depth = _mm512_maskz_loadu_ps(inside, depthRow + i);
+                    __mmask16 pass = _mm512_mask_cmp_ps_mask(inside, z, depth, _CMP_LT_OQ);
+                    if (stats) CountRasterChunk(stats, i, (unsigned int)inside, (unsigned int)pass);
+                    if (pass == 0) continue;
+
+                    _mm512_mask_storeu_ps(depthRow + i, pass, z);
+                    written += WriteMaskedColor(rgbRow + 3 * i, (unsigned int)pass, color);
+                }
+                return written;
+            }
+
+            void ConvertRGB8(const float* in, uint8_t* out, size_t count) {
+                const __m512 zero = _mm512_setzero_ps();
+                const __m512 one = _mm512_set1_ps(1.0f);
+                const __m512 scale = _mm512_set1_ps(255.99f);
+
+                size_t n = count * 3;
+                for (size_t i = 0; i < n; i += 16) {
+                    size_t remain = n - i;
+                    __mmask16 m = remain >= 16 ? (__mmask16)0xFFFF : (__mmask16)((1u << remain) - 1u);
+
+                    __m512 v = _mm512_maskz_loadu_ps(m, in + i);
+                    v = _mm512_mul_ps(_mm512_min_ps(_mm512_max_ps(v, zero), one), scale);
+                    _mm512_mask_cvtepi32_storeu_epi8(out + i, m, _mm512_cvttps_epi32(v));
+                }
+            }
+
+            // --- Compact Vertex Decode ---
+            // 12 floats of 4 vertices -> [x0 y0 z0 0 | x1 y1 z1 0 | ..]
+            inline __m512 SpreadFloat3x4(__m512 v) {
+                const __m512i spread = _mm512_setr_epi32(0, 1, 2, 0, 3, 4, 5, 0, 6, 7, 8, 0, 9, 10, 11, 0);
+                return _mm512_maskz_permutexvar_ps((__mmask16)0x7777, spread, v);
+            }
+
+            void DecodeFloat3(const float* in, float* out, size_t count) {
+                size_t i = 0;
+                for (; i + 4 <= count; i += 4) {
+                    __m512 v = _mm512_maskz_loadu_ps((__mmask16)0x0FFF, in + 3 * i);
+                    _mm512_storeu_ps(out + 4 * i, SpreadFloat3x4(v));
+                }
+                if (i < count) {
+                    size_t n = count - i;
+                    __m512 v = _mm512_maskz_loadu_ps((__mmask16)((1u << (3 * n)) - 1u), in + 3 * i);
+                    _mm512_mask_storeu_ps(out + 4 * i, TailMask(n), SpreadFloat3x4(v));
+                }
+            }
+
+            void DecodeHalf(const uint16_t* in, float* out, size_t count) {
+                size_t i = 0;
+                for (; i + 16 <= count; i += 16) {
+                    _mm512_storeu_ps(out + i, _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i*)(in + i))));
+                }
+                if (i < count) {
+                    uint16_t tmpIn[16] = {};
+                    for (size_t j = 0; j < count - i; j++) tmpIn[j] = in[i + j];
+                    __m512 v = _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i*)tmpIn));
+                    _mm512_mask_storeu_ps(out + i, (__mmask16)((1u << (count - i)) - 1u), v);
+                }
+            }
+
+            void DecodeHalf3(const uint16_t* in, float* out, size_t count) {
+                size_t i = 0;
+                // 4 vertices = 12 halfs = 6 dwords, loaded exactly
+                for (; i + 4 <= count; i += 4) {
+                    __m512i raw = _mm512_maskz_loadu_epi32((__mmask16)0x003F, in + 3 * i);
+                    __m512 v = _mm512_cvtph_ps(_mm512_castsi512_si256(raw));
+                    _mm512_storeu_ps(out + 4 * i, SpreadFloat3x4(v));
+                }
+                if (i < count) {
+                    size_t n = count - i;
+                    uint16_t tmpIn[16] = {};
+                    for (size_t j = 0; j < 3 * n; j++) tmpIn[j] = in[3 * i + j];
+                    __m512 v = _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i*)tmpIn));
+                    _mm512_mask_storeu_ps(out + 4 * i, TailMask(n), SpreadFloat3x4(v));
+                }
+            }
+
+            // 4 packed normals (lanes 0..3) -> [x0 y0 z0 0 | x1 y1 z1 0 | ..]
+            inline __m512 DecodeNormal4(__m512i packed) {
+                const __m512i broadcast = _mm512_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3);
+                // Move each 10-bit field to the top (shift >= 32 clears the w lane), then sign extend
+                const __m512i fieldShift = _mm512_setr_epi32(22, 12, 2, 32, 22, 12, 2, 32, 22, 12, 2, 32, 22, 12, 2, 32);
+
+                __m512i bits = _mm512_permutexvar_epi32(broadcast, packed);
+                bits = _mm512_srai_epi32(_mm512_sllv_epi32(bits, fieldShift), 22);
+                __m512 v = _mm512_mul_ps(_mm512_cvtepi32_ps(bits), _mm512_set1_ps(1.0f / 511.0f));
+                return _mm512_max_ps(v, _mm512_set1_ps(-1.0f));
+            }
+
+            void DecodeNormals(const uint32_t* in, float* out, size_t count) {
+                size_t i = 0;
+                for (; i + 4 <= count; i += 4) {
+                    __m512i packed = _mm512_castsi128_si512(_mm_loadu_si128((const __m128i*)(in + i)));
+                    _mm512_storeu_ps(out + 4 * i, DecodeNormal4(packed));
+                }
+                if (i < count) {
+                    size_t n = count - i;
+                    __m512i packed = _mm512_maskz_loadu_epi32((__mmask16)((1u << n) - 1u), in + i);
+                    _mm512_mask_storeu_ps(out + 4 * i, TailMask(n), DecodeNormal4(packed));
+                }
+            }
+
+            // --- SIMD Math & Texture Sampling (SimdMathImpl.inl, TextureImpl.inl) ---
+            // AVX-512F has no float logic ops (DQ), they go through the integer domain
+            struct Simd {
+                using F = __m512;
+                using I = __m512i;
+                using M = __mmask16;
+                static constexpr int Width = 16;
+
+                static F Set(float v) { return _mm512_set1_ps(v); }
+                static I SetI(int v) { return _mm512_set1_epi32(v); }
+                static F Load(const float* p) { return _mm512_loadu_ps(p); }
+                static void Store(float* p, F v) { _mm512_storeu_ps(p, v); }
+
+                static F Add(F a, F b) { return _mm512_add_ps(a, b); }
+                static F Sub(F a, F b) { return _mm512_sub_ps(a, b); }
+                static F Mul(F a, F b) { return _mm512_mul_ps(a, b); }
+                static F Div(F a, F b) { return _mm512_div_ps(a, b); }
+                static F MulAdd(F a, F b, F c) { return _mm512_fmadd_ps(a, b, c); }
+                static F Min(F a, F b) { return _mm512_min_ps(a, b); }
+                static F Max(F a, F b) { return _mm512_max_ps(a, b); }
+                static F Sqrt(F a) { return _mm512_sqrt_ps(a); }
+                static F RsqrtEstimate(F a) { return _mm512_rsqrt14_ps(a); }
+
+                static F And(F a, F b) { return _mm512_castsi512_ps(_mm512_and_si512(_mm512_castps_si512(a), _mm512_castps_si512(b))); }
+                static F AndNot(F a, F b) { return _mm512_castsi512_ps(_mm512_andnot_si512(_mm512_castps_si512(a), _mm512_castps_si512(b))); }
+                static F Xor(F a, F b) { return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(a), _mm512_castps_si512(b))); }
+
+                static M Lt(F a, F b) { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+                static M Gt(F a, F b) { return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ); }
+                static M Eq(F a, F b) { return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); }
+                static F Select(M m, F t, F f) { return _mm512_mask_blend_ps(m, f, t); }
+
+                static I Round(F a) { return _mm512_cvtps_epi32(a); }
+                static F ToFloat(I a) { return _mm512_cvtepi32_ps(a); }
+                static F AsFloat(I a) { return _mm512_castsi512_ps(a); }
+                static I IAnd(I a, I b) { return _mm512_and_si512(a, b); }
+                static I IAdd(I a, I b) { return _mm512_add_epi32(a, b); }
+                static I ISub(I a, I b) { return _mm512_sub_epi32(a, b); }
+                static M IEq(I a, I b) { return _mm512_cmpeq_epi32_mask(a, b); }
+                template <int N> static I Shl(I a) { return _mm512_slli_epi32(a, N); }
+                template <int N> static I Sar(I a) { return _mm512_srai_epi32(a, N); }
+
+                // --- Texture sampling (TextureImpl.inl) ---
+                static M Le(F a, F b) { return _mm512_cmp_ps_mask(a, b, _CMP_LE_OQ); }
+                static M MAnd(M a, M b) { return (M)(a & b); }
+                static unsigned int MaskBits(M m) { return (unsigned int)m; }
+                static F Floor(F a) { return _mm512_roundscale_ps(a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+                static I AsInt(F a) { return _mm512_castps_si512(a); }
+                static I IOr(I a, I b) { return _mm512_or_si512(a, b); }
+                static I IMul(I a, I b) { return _mm512_mullo_epi32(a, b); }
+                template <int N> static I Shr(I a) { return _mm512_srli_epi32(a, N); }
+                static I Gather(const int32_t* base, I index) { return _mm512_i32gather_epi32(index, base, 4); }
+            };
+
+            #include "SimdMathImpl.inl"
+            #include "TextureImpl.inl"
+
+            // --- 8-lane wrapper for the BVH & triangle setup kernels (8 wide, 256-bit is enough) ---
+            #include "SimdAvx8.inl"
+            using Lane8 = SimdAvx8;
+
+            #include "BvhTraverseImpl.inl"
+            #include "TriangleSetupImpl.inl"
+        }
+
+        const KernelTable TableAVX512 = {
+            SimdLevel::AVX512,
+            TransformPoints,
+            ProjectVertices,
+            SetupTriangles,
+            RasterRow,
+            RasterRowTextured,
+            SampleTexture,
+            ConvertRGB8,
+            DecodeFloat3,
+            DecodeHalf3,
+            DecodeNormals,
+            DecodeHalf,
+            SinCos,
+            Tan,
+            Atan2,
+            Acos,
+            Exp,
+            Rsqrt,
+            IntersectRays,
+            OccludedRays
+        };
+    }
+}
@@ -0,0 +1,343 @@
+// Baseline kernels (SSE4.1, 4-wide)
+#include "Kernels.h"
+#include <immintrin.h>
+
+namespace Shika {
+    namespace Kernels {
+        namespace {
+
+            inline __m128 TransformRow(__m128 p, const __m128* rows) {
+                __m128 x = _mm_shuffle_ps(p, p, _MM_SHUFFLE(0, 0, 0, 0));
+                __m128 y = _mm_shuffle_ps(p, p, _MM_SHUFFLE(1, 1, 1, 1));
+                __m128 z = _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 2, 2));
+
+                // x*Row0 + y*Row1 + z*Row2 + 1*Row3
+                __m128 r = _mm_mul_ps(x, rows[0]);
+                r = _mm_add_ps(r, _mm_mul_ps(y, rows[1]));
+                r = _mm_add_ps(r, _mm_mul_ps(z, rows[2]));
+                return _mm_add_ps(r, rows[3]);
+            }
+
+            void TransformPoints(const float* in, float* out, size_t count, const float* mat) {
+                __m128 rows[4] = {
+                    _mm_loadu_ps(mat + 0), _mm_loadu_ps(mat + 4),
+                    _mm_loadu_ps(mat + 8), _mm_loadu_ps(mat + 12)
+                };
+
+                for (size_t i = 0; i < count; i++) {
+                    _mm_storeu_ps(out + 4 * i, TransformRow(_mm_loadu_ps(in + 4 * i), rows));
+                }
+            }
+
+            void ProjectVertices(const float* in, float* out, size_t count, const float* mvp, int width, int height) {
+                __m128 rows[4] = {
+                    _mm_loadu_ps(mvp + 0), _mm_loadu_ps(mvp + 4),
+                    _mm_loadu_ps(mvp + 8), _mm_loadu_ps(mvp + 12)
+                };
+                // screenX = (x + 1) * 0.5 * width, screenY = (1 - y) * 0.5 * height, z, 1 / w
+                const __m128 sign   = _mm_set_ps(0.0f, 1.0f, -1.0f, 1.0f);
+                const __m128 bias   = _mm_set_ps(0.0f, 0.0f, 1.0f, 1.0f);
+                const __m128 scale  = _mm_set_ps(0.0f, 1.0f, 0.5f * height, 0.5f * width);
+                const __m128 one    = _mm_set1_ps(1.0f);
+                const __m128 zero   = _mm_setzero_ps();
+
+                for (size_t i = 0; i < count; i++) {
+                    __m128 r = TransformRow(_mm_loadu_ps(in + 4 * i), rows);
+
+                    // Perspective Divide (skipped if w == 0)
+                    __m128 w = _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 3, 3, 3));
+                    w = _mm_blendv_ps(w, one, _mm_cmpeq_ps(w, zero));
+                    __m128 ndc = _mm_div_ps(r, w);
+
+                    // Viewport
+                    __m128 s = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(ndc, sign), bias), scale);
+                    s = _mm_blend_ps(s, _mm_div_ps(one, w), 0x8);
+                    _mm_storeu_ps(out + 4 * i, s);
+                }
+            }
+
+            int RasterRow(const RasterRowSetup& setup, int count, float* depthRow, float* rgbRow, const float* color, RasterRowStats* stats) {
+                const __m128 lane = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+                const __m128 zero = _mm_setzero_ps();
+                const __m128 w0 = _mm_set1_ps(setup.w0), dw0 = _mm_set1_ps(setup.dw0);
+                const __m128 w1 = _mm_set1_ps(setup.w1), dw1 = _mm_set1_ps(setup.dw1);
+                const __m128 w2 = _mm_set1_ps(setup.w2), dw2 = _mm_set1_ps(setup.dw2);
+                const __m128 z0 = _mm_set1_ps(setup.z),  dz  = _mm_set1_ps(setup.dz);
+
+                int written = 0;
+                int i = 0;
+                for (; i + 4 <= count; i += 4) {
+                    __m128 fi = _mm_add_ps(_mm_set1_ps((float)i), lane);
+
+                    // Edge Test (all three edges <= 0)
+                    __m128 e0 = _mm_add_ps(w0, _mm_mul_ps(fi, dw0));
+                    __m128 e1 = _mm_add_ps(w1, _mm_mul_ps(fi, dw1));
+                    __m128 e2 = _mm_add_ps(w2, _mm_mul_ps(fi, dw2));
+                    __m128 inside = _mm_and_ps(_mm_cmple_ps(e0, zero),
+                                    _mm_and_ps(_mm_cmple_ps(e1, zero), _mm_cmple_ps(e2, zero)));
+                    if (_mm_movemask_ps(inside) == 0) continue;
+
+                    // Depth Test
+                    __m128 z = _mm_add_ps(z0, _mm_mul_ps(fi, dz));
+                    __m128 depth = _mm_loadu_ps(depthRow + i);
+                    __m128 pass = _mm_and_ps(inside, _mm_cmplt_ps(z, depth));
+
+                    unsigned int bits = (unsigned int)_mm_movemask_ps(pass);
+                    if (stats) CountRasterChunk(stats, i, (unsigned int)_mm_movemask_ps(inside), bits);
+                    if (bits == 0) continue;
+
+                    _mm_storeu_ps(depthRow + i, _mm_blendv_ps(depth, z, pass));
+                    written += WriteMaskedColor(rgbRow + 3 * i, bits, color);
+                }
+
+                // Tail
+                for (; i < count; i++) {
+                    float fi = (float)i;
+                    float e0 = setup.w0 + fi * setup.dw0;
+                    float e1 = setup.w1 + fi * setup.dw1;
+                    float e2 = setup.w2 + fi * setup.dw2;
+                    if (e0 > 0 || e1 > 0 || e2 > 0) continue;
+
+                    float z = setup.z + fi * setup.dz;
+                    bool pass = z < depthRow[i];
+                    if (stats) CountRasterChunk(stats, i, 1u, pass ? 1u : 0u);
+                    if (pass) {
+                        depthRow[i] = z;
+                        written += WriteMaskedColor(rgbRow + 3 * i, 1u, color);
+                    }
+                }
+                return written;
+            }
+
+            inline __m128i ToInt255(__m128 v) {
+                const __m128 zero = _mm_setzero_ps();
+                const __m128 one = _mm_set1_ps(1.0f);
+                const __m128 scale = _mm_set1_ps(255.99f);
+                return _mm_cvttps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(v, zero), one), scale));
+            }
+
+            void ConvertRGB8(const float* in, uint8_t* out, size_t count) {
+                size_t n = count * 3;
+                size_t i = 0;
+                for (; i + 16 <= n; i += 16) {
+                    __m128i a = ToInt255(_mm_loadu_ps(in + i + 0));
+                    __m128i b = ToInt255(_mm_loadu_ps(in + i + 4));
+                    __m128i c = ToInt255(_mm_loadu_ps(in + i + 8));
+                    __m128i d = ToInt255(_mm_loadu_ps(in + i + 12));
+                    __m128i packed = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+                    _mm_storeu_si128((__m128i*)(out + i), packed);
+                }
+                for (; i < n; i++) {
+                    float v = in[i];
+                    v = v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v);
+                    out[i] = (uint8_t)(int)(v * 255.99f);
+                }
+            }
+
+            // --- Compact Vertex Decode ---
+            void DecodeFloat3(const float* in, float* out, size_t count) {
+                const __m128 zero = _mm_setzero_ps();
+                for (size_t i = 0; i < count; i++) {
+                    // 16-byte load reads the next vertex's x, the last vertex is loaded by components
+                    __m128 v = (i + 1 < count) ? _mm_loadu_ps(in + 3 * i)
+                                               : _mm_setr_ps(in[3 * i], in[3 * i + 1], in[3 * i + 2], 0.0f);
+                    _mm_storeu_ps(out + 4 * i, _mm_blend_ps(v, zero, 0x8));
+                }
+            }
+
+            // 4 halfs (zero extended to 32-bit lanes) -> 4 floats
+            inline __m128 HalfToFloat4(__m128i h) {
+                const __m128i shiftedExp = _mm_set1_epi32(0x7C00 << 13);
+                const __m128i expAdjust  = _mm_set1_epi32((127 - 15) << 23);
+                const __m128i one        = _mm_set1_epi32(1 << 23);
+                const __m128  magic      = _mm_castsi128_ps(_mm_set1_epi32(113 << 23));
+
+                __m128i o = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x7FFF)), 13);
+                __m128i exp = _mm_and_si128(o, shiftedExp);
+                o = _mm_add_epi32(o, expAdjust);
+
+                // Inf / NaN : extra exponent adjust
+                __m128i infNan = _mm_cmpeq_epi32(exp, shiftedExp);
+                o = _mm_add_epi32(o, _mm_and_si128(infNan, expAdjust));
+
+                // Zero / Subnormal : renormalize through the FPU
+                __m128i denorm = _mm_cmpeq_epi32(exp, _mm_setzero_si128());
+                __m128 renorm = _mm_sub_ps(_mm_castsi128_ps(_mm_add_epi32(o, one)), magic);
+                __m128 f = _mm_blendv_ps(_mm_castsi128_ps(o), renorm, _mm_castsi128_ps(denorm));
+
+                __m128i sign = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x8000)), 16);
+                return _mm_or_ps(f, _mm_castsi128_ps(sign));
+            }
+
+            void DecodeHalf(const uint16_t* in, float* out, size_t count) {
+                size_t i = 0;
+                for (; i + 4 <= count; i += 4) {
+                    __m128i h = _mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i*)(in + i)));
+                    _mm_storeu_ps(out + i, HalfToFloat4(h));
+                }
+                if (i < count) {
+                    uint16_t tmpIn[4] = {};
+                    float tmpOut[4];
+                    for (size_t j = 0; j < count - i; j++) tmpIn[j] = in[i + j];
+                    _mm_storeu_ps(tmpOut, HalfToFloat4(_mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i*)tmpIn))));
+                    for (size_t j = 0; j < count - i; j++) out[i + j] = tmpOut[j];
+                }
+            }
+
+            void DecodeHalf3(const uint16_t* in, float* out, size_t count) {
+                const __m128 zero = _mm_setzero_ps();
+                for (size_t i = 0; i < count; i++) {
+                    // 8-byte load reads the next vertex's x, the last vertex goes through a padded copy
+                    __m128i raw;
+                    if (i + 1 < count) {
+                        raw = _mm_loadl_epi64((const __m128i*)(in + 3 * i));
+                    } else {
+                        uint16_t tmp[4] = { in[3 * i], in[3 * i + 1], in[3 * i + 2], 0 };
+                        raw = _mm_loadl_epi64((const __m128i*)tmp);
+                    }
+                    __m128 v = HalfToFloat4(_mm_cvtepu16_epi32(raw));
+                    _mm_storeu_ps(out + 4 * i, _mm_blend_ps(v, zero, 0x8));
+                }
+            }
+
+            void DecodeNormals(const uint32_t* in, float* out, size_t count) {
+                // Move each 10-bit field to the top (w lane : * 0), then arithmetic shift = sign extend
+                const __m128i fieldShift = _mm_setr_epi32(1 << 22, 1 << 12, 1 << 2, 0);
+                const __m128 scale = _mm_set1_ps(1.0f / 511.0f);
+                const __m128 minusOne = _mm_set1_ps(-1.0f);
+
+                for (size_t i = 0; i < count; i++) {
+                    __m128i bits = _mm_mullo_epi32(_mm_set1_epi32((int)in[i]), fieldShift);
+                    __m128 v = _mm_cvtepi32_ps(_mm_srai_epi32(bits, 22));
+                    _mm_storeu_ps(out + 4 * i, _mm_max_ps(_mm_mul_ps(v, scale), minusOne));
+                }
+            }
+
+            // --- SIMD Math & Texture Sampling (SimdMathImpl.inl, TextureImpl.inl) ---
+            struct Simd {
+                using F = __m128;
+                using I = __m128i;
+                using M = __m128;
+                static constexpr int Width = 4;
+
+                static F Set(float v) { return _mm_set1_ps(v); }
+                static I SetI(int v) { return _mm_set1_epi32(v); }
+                static F Load(const float* p) { return _mm_loadu_ps(p); }
+                static void Store(float* p, F v) { _mm_storeu_ps(p, v); }
+
+                static F Add(F a, F b) { return _mm_add_ps(a, b); }
+                static F Sub(F a, F b) { return _mm_sub_ps(a, b); }
+                static F Mul(F a, F b) { return _mm_mul_ps(a, b); }
+                static F Div(F a, F b) { return _mm_div_ps(a, b); }
+                static F MulAdd(F a, F b, F c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+                static F Min(F a, F b) { return _mm_min_ps(a, b); }
+                static F Max(F a, F b) { return _mm_max_ps(a, b); }
+                static F Sqrt(F a) { return _mm_sqrt_ps(a); }
+                static F RsqrtEstimate(F a) { return _mm_rsqrt_ps(a); }
+
+                static F And(F a, F b) { return _mm_and_ps(a, b); }
+                static F AndNot(F a, F b) { return _mm_andnot_ps(a, b); }
+                static F Xor(F a, F b) { return _mm_xor_ps(a, b); }
+
+                static M Lt(F a, F b) { return _mm_cmplt_ps(a, b); }
+                static M Gt(F a, F b) { return _mm_cmpgt_ps(a, b); }
+                static M Eq(F a, F b) { return _mm_cmpeq_ps(a, b); }
+                static F Select(M m, F t, F f) { return _mm_blendv_ps(f, t, m); }
+
+                static I Round(F a) { return _mm_cvtps_epi32(a); }
+                static F ToFloat(I a) { return _mm_cvtepi32_ps(a); }
+                static F AsFloat(I a) { return _mm_castsi128_ps(a); }
+                static I IAnd(I a, I b) { return _mm_and_si128(a, b); }
+                static I IAdd(I a, I b) { return _mm_add_epi32(a, b); }
+                static I ISub(I a, I b) { return _mm_sub_epi32(a, b); }
+                static M IEq(I a, I b) { return _mm_castsi128_ps(_mm_cmpeq_epi32(a, b)); }
+                template <int N> static I Shl(I a) { return _mm_slli_epi32(a, N); }
+                template <int N> static I Sar(I a) { return _mm_srai_epi32(a, N); }
+
+                // --- Texture sampling (TextureImpl.inl) ---
+                static M Le(F a, F b) { return _mm_cmple_ps(a, b); }
+                static M MAnd(M a, M b) { return _mm_and_ps(a, b); }
+                static unsigned int MaskBits(M m) { return (unsigned int)_mm_movemask_ps(m); }
+                static F Floor(F a) { return _mm_floor_ps(a); }
+                static I AsInt(F a) { return _mm_castps_si128(a); }
+                static I IOr(I a, I b) { return _mm_or_si128(a, b); }
+                static I IMul(I a, I b) { return _mm_mullo_epi32(a, b); }
+                template <int N> static I Shr(I a) { return _mm_srli_epi32(a, N); }
+                // No hardware gather before AVX2
+                static I Gather(const int32_t* base, I index) {
+                    return _mm_setr_epi32(base[_mm_extract_epi32(index, 0)], base[_mm_extract_epi32(index, 1)],
+                                          base[_mm_extract_epi32(index, 2)], base[_mm_extract_epi32(index, 3)]);
+                }
+            };
+
+            #include "SimdMathImpl.inl"
+            #include "TextureImpl.inl"
+
+            // --- 8-lane wrapper for the BVH & triangle setup kernels (two SSE registers) ---
+            struct Lane8 {
+                struct F { __m128 lo, hi; };
+
+                static F Set(float a) { __m128 v = _mm_set1_ps(a); return { v, v }; }
+                static F Load(const float* p) { return { _mm_load_ps(p), _mm_load_ps(p + 4) }; }
+                static void Store(float* p, F a) { _mm_store_ps(p, a.lo); _mm_store_ps(p + 4, a.hi); }
+
+                static F Add(F a, F b) { return { _mm_add_ps(a.lo, b.lo), _mm_add_ps(a.hi, b.hi) }; }
+                static F Sub(F a, F b) { return { _mm_sub_ps(a.lo, b.lo), _mm_sub_ps(a.hi, b.hi) }; }
+                static F Mul(F a, F b) { return { _mm_mul_ps(a.lo, b.lo), _mm_mul_ps(a.hi, b.hi) }; }
+                static F Div(F a, F b) { return { _mm_div_ps(a.lo, b.lo), _mm_div_ps(a.hi, b.hi) }; }
+                static F MulAdd(F a, F b, F c) { return Add(Mul(a, b), c); }
+                static F MulSub(F a, F b, F c) { return Sub(Mul(a, b), c); }
+                static F Min(F a, F b) { return { _mm_min_ps(a.lo, b.lo), _mm_min_ps(a.hi, b.hi) }; }
+                static F Max(F a, F b) { return { _mm_max_ps(a.lo, b.lo), _mm_max_ps(a.hi, b.hi) }; }
+
+                static F And(F a, F b) { return { _mm_and_ps(a.lo, b.lo), _mm_and_ps(a.hi, b.hi) }; }
+                static F Lt(F a, F b) { return { _mm_cmplt_ps(a.lo, b.lo), _mm_cmplt_ps(a.hi, b.hi) }; }
+                static F Le(F a, F b) { return { _mm_cmple_ps(a.lo, b.lo), _mm_cmple_ps(a.hi, b.hi) }; }
+                static F Gt(F a, F b) { return { _mm_cmpgt_ps(a.lo, b.lo), _mm_cmpgt_ps(a.hi, b.hi) }; }
+                static F Ge(F a, F b) { return { _mm_cmpge_ps(a.lo, b.lo), _mm_cmpge_ps(a.hi, b.hi) }; }
+                static F Neq(F a, F b) { return { _mm_cmpneq_ps(a.lo, b.lo), _mm_cmpneq_ps(a.hi, b.hi) }; }
+                static F Eq(F a, F b) { return { _mm_cmpeq_ps(a.lo, b.lo), _mm_cmpeq_ps(a.hi, b.hi) }; }
+                static F Or(F a, F b) { return { _mm_or_ps(a.lo, b.lo), _mm_or_ps(a.hi, b.hi) }; }
+                static F Floor(F a) { return { _mm_floor_ps(a.lo), _mm_floor_ps(a.hi) }; }
+                static F Ceil(F a) { return { _mm_ceil_ps(a.lo), _mm_ceil_ps(a.hi) }; }
+                static unsigned int MaskBits(F m) { return (unsigned int)(_mm_movemask_ps(m.lo) | (_mm_movemask_ps(m.hi) << 4)); }
+
+                // x, y, z, w of 8 vertices (Vector3 layout)
+                static void LoadTransposed(const float* const* p, F& x, F& y, F& z, F& w) {
+                    __m128 a = _mm_loadu_ps(p[0]), b = _mm_loadu_ps(p[1]), c = _mm_loadu_ps(p[2]), d = _mm_loadu_ps(p[3]);
+                    _MM_TRANSPOSE4_PS(a, b, c, d);
+                    x.lo = a; y.lo = b; z.lo = c; w.lo = d;
+                    a = _mm_loadu_ps(p[4]); b = _mm_loadu_ps(p[5]); c = _mm_loadu_ps(p[6]); d = _mm_loadu_ps(p[7]);
+                    _MM_TRANSPOSE4_PS(a, b, c, d);
+                    x.hi = a; y.hi = b; z.hi = c; w.hi = d;
+                }
+            };
+
+            #include "BvhTraverseImpl.inl"
+            #include "TriangleSetupImpl.inl"
+        }
+
+        const KernelTable TableSSE41 = {
+            SimdLevel::SSE41,
+            TransformPoints,
+            ProjectVertices,
+            SetupTriangles,
+            RasterRow,
+            RasterRowTextured,
+            SampleTexture,
+            ConvertRGB8,
+            DecodeFloat3,
+            DecodeHalf3,
+            DecodeNormals,
+            DecodeHalf,
+            SinCos,
+            Tan,
+            Atan2,
+            Acos,
+            Exp,
+            Rsqrt,
+            IntersectRays,
+            OccludedRays
+        };
+    }
+}
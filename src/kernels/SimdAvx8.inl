@@ -0,0 +1,72 @@
+// 8-wide AVX2 + FMA wrapper : `Simd` of Kernels_AVX2.cpp, `Lane8` of Kernels_AVX2.cpp & Kernels_AVX512.cpp.
+// Included inside the kernel TU's anonymous namespace (each ISA gets its own copy, no ODR sharing).
+// F : 8 floats, I : 8 int32, M : lane mask (a float vector, so masks combine with And / Or).
+
+struct SimdAvx8 {
+    using F = __m256;
+    using I = __m256i;
+    using M = __m256;
+    static constexpr int Width = 8;
+
+    static F Set(float v) { return _mm256_set1_ps(v); }
+    static I SetI(int v) { return _mm256_set1_epi32(v); }
+    static F Load(const float* p) { return _mm256_loadu_ps(p); }
+    static void Store(float* p, F v) { _mm256_storeu_ps(p, v); }
+
+    static F Add(F a, F b) { return _mm256_add_ps(a, b); }
+    static F Sub(F a, F b) { return _mm256_sub_ps(a, b); }
+    static F Mul(F a, F b) { return _mm256_mul_ps(a, b); }
+    static F Div(F a, F b) { return _mm256_div_ps(a, b); }
+    static F MulAdd(F a, F b, F c) { return _mm256_fmadd_ps(a, b, c); }
+    static F MulSub(F a, F b, F c) { return _mm256_fmsub_ps(a, b, c); }
+    static F Min(F a, F b) { return _mm256_min_ps(a, b); }
+    static F Max(F a, F b) { return _mm256_max_ps(a, b); }
+    static F Sqrt(F a) { return _mm256_sqrt_ps(a); }
+    static F RsqrtEstimate(F a) { return _mm256_rsqrt_ps(a); }
+    static F Floor(F a) { return _mm256_floor_ps(a); }
+    static F Ceil(F a) { return _mm256_ceil_ps(a); }
+
+    static F And(F a, F b) { return _mm256_and_ps(a, b); }
+    static F AndNot(F a, F b) { return _mm256_andnot_ps(a, b); }
+    static F Or(F a, F b) { return _mm256_or_ps(a, b); }
+    static F Xor(F a, F b) { return _mm256_xor_ps(a, b); }
+
+    static M Lt(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static M Le(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+    static M Gt(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    static M Ge(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+    static M Eq(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+    static M Neq(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_NEQ_OQ); }
+    static M MAnd(M a, M b) { return _mm256_and_ps(a, b); }
+    static F Select(M m, F t, F f) { return _mm256_blendv_ps(f, t, m); }
+    static unsigned int MaskBits(M m) { return (unsigned int)_mm256_movemask_ps(m); }
+
+    static I Round(F a) { return _mm256_cvtps_epi32(a); }
+    static F ToFloat(I a) { return _mm256_cvtepi32_ps(a); }
+    static F AsFloat(I a) { return _mm256_castsi256_ps(a); }
+    static I AsInt(F a) { return _mm256_castps_si256(a); }
+    static I IAnd(I a, I b) { return _mm256_and_si256(a, b); }
+    static I IOr(I a, I b) { return _mm256_or_si256(a, b); }
+    static I IAdd(I a, I b) { return _mm256_add_epi32(a, b); }
+    static I ISub(I a, I b) { return _mm256_sub_epi32(a, b); }
+    static I IMul(I a, I b) { return _mm256_mullo_epi32(a, b); }
+    static M IEq(I a, I b) { return _mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)); }
+    template <int N> static I Shl(I a) { return _mm256_slli_epi32(a, N); }
+    template <int N> static I Shr(I a) { return _mm256_srli_epi32(a, N); }
+    template <int N> static I Sar(I a) { return _mm256_srai_epi32(a, N); }
+    static I Gather(const int32_t* base, I index) { return _mm256_i32gather_epi32(base, index, 4); }
+
+    // x, y, z, w of 8 vertices (Vector3 layout) : lanes 0-3 in the low half, 4-7 in the high half
+    static void LoadTransposed(const float* const* p, F& x, F& y, F& z, F& w) {
+        __m256 a = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p[0])), _mm_loadu_ps(p[4]), 1);
+        __m256 b = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p[1])), _mm_loadu_ps(p[5]), 1);
+        __m256 c = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p[2])), _mm_loadu_ps(p[6]), 1);
+        __m256 d = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p[3])), _mm_loadu_ps(p[7]), 1);
+        __m256 xy01 = _mm256_unpacklo_ps(a, b), xy23 = _mm256_unpacklo_ps(c, d); // x0 x1 y0 y1 | x2 x3 y2 y3
+        __m256 zw01 = _mm256_unpackhi_ps(a, b), zw23 = _mm256_unpackhi_ps(c, d);
+        x = _mm256_shuffle_ps(xy01, xy23, _MM_SHUFFLE(1, 0, 1, 0));
+        y = _mm256_shuffle_ps(xy01, xy23, _MM_SHUFFLE(3, 2, 3, 2));
+        z = _mm256_shuffle_ps(zw01, zw23, _MM_SHUFFLE(1, 0, 1, 0));
+        w = _mm256_shuffle_ps(zw01, zw23, _MM_SHUFFLE(3, 2, 3, 2));
+    }
+};
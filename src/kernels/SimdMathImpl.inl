@@ -0,0 +1,225 @@
+// Shared SIMD math kernels (SimdMath.h).
+// Included by every Kernels_*.cpp inside its anonymous namespace, after the ISA wrapper
+// `struct Simd` (F : float vector, I : int32 vector, M : lane mask, Width) is defined.
+// Polynomials are the Cephes single precision minimax sets.
+
+// --- Batch Loop Helpers ---
+// Full vectors in place, the tail through a zero padded copy
+
+template <typename Fn>
+inline void ForEach1(const float* in, float* out, size_t count, Fn fn) {
+    const size_t W = Simd::Width;
+    size_t i = 0;
+    for (; i + W <= count; i += W) {
+        Simd::Store(out + i, fn(Simd::Load(in + i)));
+    }
+    if (i < count) {
+        float tmpIn[Simd::Width] = {}, tmpOut[Simd::Width];
+        for (size_t j = 0; j < count - i; j++) tmpIn[j] = in[i + j];
+        Simd::Store(tmpOut, fn(Simd::Load(tmpIn)));
+        for (size_t j = 0; j < count - i; j++) out[i + j] = tmpOut[j];
+    }
+}
+
+// --- Range Reduction ---
+// x = j * (pi / 2) + r, |r| <= pi / 4
+// 4-part Cody-Waite : C1..C3 have 12 significant bits, so j * C1..C3 is exact for |j| < 2^12
+// (|x| < 6434) even without FMA, C4 carries the rest of pi / 2
+inline Simd::F ReduceHalfPi(Simd::F x, Simd::I& quadrant) {
+    quadrant = Simd::Round(Simd::Mul(x, Simd::Set(0.636619772367581f)));
+    Simd::F j = Simd::ToFloat(quadrant);
+    Simd::F r = Simd::MulAdd(j, Simd::Set(-1.5703125f), x);
+    r = Simd::MulAdd(j, Simd::Set(-4.837512969970703125e-4f), r);
+    r = Simd::MulAdd(j, Simd::Set(-7.549533620476723e-8f), r);
+    r = Simd::MulAdd(j, Simd::Set(-2.5633440682570896e-12f), r);
+    return r;
+}
+
+inline Simd::F Abs(Simd::F x) {
+    return Simd::AndNot(Simd::Set(-0.0f), x);
+}
+
+// --- sin / cos ---
+inline void SinCosVec(Simd::F x, Simd::F& sinOut, Simd::F& cosOut) {
+    Simd::I q;
+    Simd::F r = ReduceHalfPi(x, q);
+    Simd::F z = Simd::Mul(r, r);
+
+    // sin(r) = r + r^3 * P(r^2)
+    Simd::F ps = Simd::MulAdd(z, Simd::Set(-1.9515295891e-4f), Simd::Set(8.3321608736e-3f));
+    ps = Simd::MulAdd(ps, z, Simd::Set(-1.6666654611e-1f));
+    Simd::F s = Simd::MulAdd(Simd::Mul(ps, z), r, r);
+
+    // cos(r) = 1 - r^2 / 2 + r^4 * Q(r^2)
+    Simd::F pc = Simd::MulAdd(z, Simd::Set(2.443315711809948e-5f), Simd::Set(-1.388731625493765e-3f));
+    pc = Simd::MulAdd(pc, z, Simd::Set(4.166664568298827e-2f));
+    Simd::F c = Simd::MulAdd(Simd::Mul(pc, z), z, Simd::MulAdd(z, Simd::Set(-0.5f), Simd::Set(1.0f)));
+
+    // Quadrant : odd -> swap, sin negated in q = 2, 3 / cos negated in q = 1, 2
+    Simd::M swap = Simd::IEq(Simd::IAnd(q, Simd::SetI(1)), Simd::SetI(1));
+    Simd::F sinSign = Simd::AsFloat(Simd::Shl<30>(Simd::IAnd(q, Simd::SetI(2))));
+    Simd::F cosSign = Simd::AsFloat(Simd::Shl<30>(Simd::IAnd(Simd::IAdd(q, Simd::SetI(1)), Simd::SetI(2))));
+
+    sinOut = Simd::Xor(Simd::Select(swap, c, s), sinSign);
+    cosOut = Simd::Xor(Simd::Select(swap, s, c), cosSign);
+}
+
+void SinCos(const float* x, float* sinOut, float* cosOut, size_t count) {
+    const size_t W = Simd::Width;
+    size_t i = 0;
+    Simd::F s, c;
+    for (; i + W <= count; i += W) {
+        SinCosVec(Simd::Load(x + i), s, c);
+        Simd::Store(sinOut + i, s);
+        Simd::Store(cosOut + i, c);
+    }
+    if (i < count) {
+        float tmpIn[Simd::Width] = {}, tmpSin[Simd::Width], tmpCos[Simd::Width];
+        for (size_t j = 0; j < count - i; j++) tmpIn[j] = x[i + j];
+        SinCosVec(Simd::Load(tmpIn), s, c);
+        Simd::Store(tmpSin, s);
+        Simd::Store(tmpCos, c);
+        for (size_t j = 0; j < count - i; j++) {
+            sinOut[i + j] = tmpSin[j];
+            cosOut[i + j] = tmpCos[j];
+        }
+    }
+}
+
+// --- tan ---
+inline Simd::F TanVec(Simd::F x) {
+    Simd::I q;
+    Simd::F r = ReduceHalfPi(x, q);
+    Simd::F z = Simd::Mul(r, r);
+
+    Simd::F p = Simd::MulAdd(z, Simd::Set(9.38540185543e-3f), Simd::Set(3.11992232697e-3f));
+    p = Simd::MulAdd(p, z, Simd::Set(2.44301354525e-2f));
+    p = Simd::MulAdd(p, z, Simd::Set(5.34112807005e-2f));
+    p = Simd::MulAdd(p, z, Simd::Set(1.33387994085e-1f));
+    p = Simd::MulAdd(p, z, Simd::Set(3.33331568548e-1f));
+    Simd::F t = Simd::MulAdd(Simd::Mul(p, z), r, r);
+
+    // Odd quadrant : tan(r + pi/2) = -1 / tan(r)
+    Simd::M odd = Simd::IEq(Simd::IAnd(q, Simd::SetI(1)), Simd::SetI(1));
+    return Simd::Select(odd, Simd::Div(Simd::Set(-1.0f), t), t);
+}
+
+void Tan(const float* x, float* out, size_t count) {
+    ForEach1(x, out, count, TanVec);
+}
+
+// --- atan2 ---
+// atan(t) for t in [0, 1]
+inline Simd::F AtanUnit(Simd::F t) {
+    // t > tan(pi/8) : atan(t) = pi/4 + atan((t - 1) / (t + 1))
+    Simd::M upper = Simd::Gt(t, Simd::Set(0.4142135623730950f));
+    Simd::F base = Simd::Select(upper, Simd::Set(0.785398163397448f), Simd::Set(0.0f));
+    Simd::F one = Simd::Set(1.0f);
+    t = Simd::Select(upper, Simd::Div(Simd::Sub(t, one), Simd::Add(t, one)), t);
+
+    Simd::F z = Simd::Mul(t, t);
+    Simd::F p = Simd::MulAdd(z, Simd::Set(8.05374449538e-2f), Simd::Set(-1.38776856032e-1f));
+    p = Simd::MulAdd(p, z, Simd::Set(1.99777106478e-1f));
+    p = Simd::MulAdd(p, z, Simd::Set(-3.33329491539e-1f));
+    return Simd::Add(base, Simd::MulAdd(Simd::Mul(p, z), t, t));
+}
+
+inline Simd::F Atan2Vec(Simd::F y, Simd::F x) {
+    Simd::F ax = Abs(x), ay = Abs(y);
+    Simd::F mn = Simd::Min(ax, ay), mx = Simd::Max(ax, ay);
+    Simd::F zero = Simd::Set(0.0f);
+
+    // atan2(0, 0) = 0
+    Simd::F t = Simd::Select(Simd::Eq(mx, zero), zero, Simd::Div(mn, mx));
+    Simd::F r = AtanUnit(t);
+
+    r = Simd::Select(Simd::Gt(ay, ax), Simd::Sub(Simd::Set(1.57079632679490f), r), r);
+    r = Simd::Select(Simd::Lt(x, zero), Simd::Sub(Simd::Set(3.14159265358979f), r), r);
+    return Simd::Xor(r, Simd::And(y, Simd::Set(-0.0f)));
+}
+
+void Atan2(const float* y, const float* x, float* out, size_t count) {
+    const size_t W = Simd::Width;
+    size_t i = 0;
+    for (; i + W <= count; i += W) {
+        Simd::Store(out + i, Atan2Vec(Simd::Load(y + i), Simd::Load(x + i)));
+    }
+    if (i < count) {
+        float tmpY[Simd::Width] = {}, tmpX[Simd::Width] = {}, tmpOut[Simd::Width];
+        for (size_t j = 0; j < count - i; j++) { tmpY[j] = y[i + j]; tmpX[j] = x[i + j]; }
+        Simd::Store(tmpOut, Atan2Vec(Simd::Load(tmpY), Simd::Load(tmpX)));
+        for (size_t j = 0; j < count - i; j++) out[i + j] = tmpOut[j];
+    }
+}
+
+// --- acos ---
+inline Simd::F AcosVec(Simd::F x) {
+    Simd::F ax = Abs(x);
+    Simd::F half = Simd::Set(0.5f);
+
+    // |x| > 0.5 : asin(|x|) = pi/2 - 2 * asin(sqrt((1 - |x|) / 2))
+    Simd::M big = Simd::Gt(ax, half);
+    Simd::F z = Simd::Select(big, Simd::Mul(half, Simd::Sub(Simd::Set(1.0f), ax)), Simd::Mul(ax, ax));
+    Simd::F s = Simd::Select(big, Simd::Sqrt(z), ax);
+
+    Simd::F p = Simd::MulAdd(z, Simd::Set(4.2163199048e-2f), Simd::Set(2.4181311049e-2f));
+    p = Simd::MulAdd(p, z, Simd::Set(4.5470025998e-2f));
+    p = Simd::MulAdd(p, z, Simd::Set(7.4953002686e-2f));
+    p = Simd::MulAdd(p, z, Simd::Set(1.6666752422e-1f));
+    Simd::F a = Simd::MulAdd(Simd::Mul(p, z), s, s);
+
+    // acos(|x|), then acos(-x) = pi - acos(x)
+    a = Simd::Select(big, Simd::Add(a, a), Simd::Sub(Simd::Set(1.57079632679490f), a));
+    return Simd::Select(Simd::Lt(x, Simd::Set(0.0f)), Simd::Sub(Simd::Set(3.14159265358979f), a), a);
+}
+
+void Acos(const float* x, float* out, size_t count) {
+    ForEach1(x, out, count, AcosVec);
+}
+
+// --- exp ---
+inline Simd::F ExpVec(Simd::F x) {
+    const float maxArg = 88.72283935546875f; // ln(FLT_MAX)
+    Simd::M overflow = Simd::Gt(x, Simd::Set(maxArg));
+    Simd::F cx = Simd::Min(Simd::Max(x, Simd::Set(-103.9720840454f)), Simd::Set(maxArg));
+
+    // x = n * ln2 + r
+    Simd::I n = Simd::Round(Simd::Mul(cx, Simd::Set(1.44269504088896341f)));
+    Simd::F fn = Simd::ToFloat(n);
+    Simd::F r = Simd::MulAdd(fn, Simd::Set(-0.693359375f), cx);
+    r = Simd::MulAdd(fn, Simd::Set(2.12194440e-4f), r);
+
+    Simd::F p = Simd::MulAdd(r, Simd::Set(1.9875691500e-4f), Simd::Set(1.3981999507e-3f));
+    p = Simd::MulAdd(p, r, Simd::Set(8.3334519073e-3f));
+    p = Simd::MulAdd(p, r, Simd::Set(4.1665795894e-2f));
+    p = Simd::MulAdd(p, r, Simd::Set(1.6666665459e-1f));
+    p = Simd::MulAdd(p, r, Simd::Set(5.0000001201e-1f));
+    Simd::F y = Simd::Add(Simd::MulAdd(Simd::Mul(p, r), r, r), Simd::Set(1.0f));
+
+    // 2^n in two normal factors (n in [-150, 128]) : keeps denormal results correct
+    Simd::I n1 = Simd::Sar<1>(n);
+    Simd::I n2 = Simd::ISub(n, n1);
+    Simd::F s1 = Simd::AsFloat(Simd::Shl<23>(Simd::IAdd(n1, Simd::SetI(127))));
+    Simd::F s2 = Simd::AsFloat(Simd::Shl<23>(Simd::IAdd(n2, Simd::SetI(127))));
+    y = Simd::Mul(Simd::Mul(y, s1), s2);
+
+    return Simd::Select(overflow, Simd::AsFloat(Simd::SetI(0x7F800000)), y);
+}
+
+void Exp(const float* x, float* out, size_t count) {
+    ForEach1(x, out, count, ExpVec);
+}
+
+// --- rsqrt ---
+// Hardware estimate + one Newton-Raphson step : y = y * (1.5 - 0.5 * x * y * y)
+inline Simd::F RsqrtVec(Simd::F x) {
+    Simd::F y = Simd::RsqrtEstimate(x);
+    Simd::F hxy = Simd::Mul(Simd::Mul(Simd::Set(0.5f), x), y);
+    Simd::F refined = Simd::Mul(y, Simd::MulAdd(Simd::Sub(Simd::Set(0.0f), hxy), y, Simd::Set(1.5f)));
+    // rsqrt(0) = inf (the Newton step would produce NaN)
+    return Simd::Select(Simd::Eq(x, Simd::Set(0.0f)), y, refined);
+}
+
+void Rsqrt(const float* x, float* out, size_t count) {
+    ForEach1(x, out, count, RsqrtVec);
+}
@@ -0,0 +1,213 @@
+// Shared texture sampling kernels (Texture.h).
+// Included by every Kernels_*.cpp inside its anonymous namespace, after `struct Simd`.
+// Each lane picks its own mip level, level parameters are gathered from the TextureView tables.
+// Texture::Sample (Texture.cpp) is the scalar reference of these kernels.
+
+// --- Texel Addressing ---
+struct LevelLanes {
+    Simd::I offset, width, height, mortonMask;
+    Simd::F fwidth, fheight;
+};
+
+inline LevelLanes GatherLevel(const TextureView& tex, Simd::I level) {
+    LevelLanes l;
+    l.offset = Simd::Gather(tex.offset, level);
+    l.width = Simd::Gather(tex.width, level);
+    l.height = Simd::Gather(tex.height, level);
+    l.mortonMask = Simd::Gather(tex.mortonMask, level);
+    l.fwidth = Simd::ToFloat(l.width);
+    l.fheight = Simd::ToFloat(l.height);
+    return l;
+}
+
+// Spread the low 16 bits to the even bit positions
+inline Simd::I Part1By1(Simd::I x) {
+    x = Simd::IAnd(Simd::IOr(x, Simd::Shl<8>(x)), Simd::SetI(0x00FF00FF));
+    x = Simd::IAnd(Simd::IOr(x, Simd::Shl<4>(x)), Simd::SetI(0x0F0F0F0F));
+    x = Simd::IAnd(Simd::IOr(x, Simd::Shl<2>(x)), Simd::SetI(0x33333333));
+    x = Simd::IAnd(Simd::IOr(x, Simd::Shl<1>(x)), Simd::SetI(0x55555555));
+    return x;
+}
+
+inline Simd::I TexelIndex(const TextureView& tex, const LevelLanes& l, Simd::I x, Simd::I y) {
+    if (tex.layout == 0) {
+        // Row-major
+        return Simd::IAdd(l.offset, Simd::IAdd(Simd::IMul(y, l.width), x));
+    }
+    // Morton : low bits interleaved (x even, y odd), the rest of the longer side above them
+    Simd::I lx = Simd::IAnd(x, l.mortonMask), ly = Simd::IAnd(y, l.mortonMask);
+    Simd::I low = Simd::IOr(Part1By1(lx), Simd::Shl<1>(Part1By1(ly)));
+    Simd::I high = Simd::IMul(Simd::IAdd(Simd::ISub(x, lx), Simd::ISub(y, ly)), Simd::IAdd(l.mortonMask, Simd::SetI(1)));
+    return Simd::IAdd(l.offset, Simd::IAdd(low, high));
+}
+
+// Integer texel coordinate (float) -> [0, size)
+// The final clamp also keeps NaN / huge coordinates (lanes outside the triangle) inside the texture
+inline Simd::I WrapCoord(const TextureView& tex, Simd::F c, Simd::F size) {
+    if (tex.wrap == 0) {
+        // Repeat (+ fix up the rounding of the division)
+        c = Simd::Sub(c, Simd::Mul(size, Simd::Floor(Simd::Div(c, size))));
+        c = Simd::Select(Simd::Lt(c, Simd::Set(0.0f)), Simd::Add(c, size), c);
+        c = Simd::Select(Simd::Lt(c, size), c, Simd::Sub(c, size));
+    }
+    // max(NaN, 0) = 0 (x86 min/max return the second operand on NaN)
+    return Simd::Round(Simd::Min(Simd::Max(c, Simd::Set(0.0f)), Simd::Sub(size, Simd::Set(1.0f))));
+}
+
+struct RgbLanes {
+    Simd::F r, g, b;
+};
+
+inline RgbLanes FetchTexels(const TextureView& tex, Simd::I index) {
+    const Simd::I texel = Simd::Gather(reinterpret_cast<const int32_t*>(tex.texels), index);
+    const Simd::I byteMask = Simd::SetI(0xFF);
+    const Simd::F scale = Simd::Set(1.0f / 255.0f);
+    RgbLanes c;
+    c.r = Simd::Mul(Simd::ToFloat(Simd::IAnd(texel, byteMask)), scale);
+    c.g = Simd::Mul(Simd::ToFloat(Simd::IAnd(Simd::Shr<8>(texel), byteMask)), scale);
+    c.b = Simd::Mul(Simd::ToFloat(Simd::IAnd(Simd::Shr<16>(texel), byteMask)), scale);
+    return c;
+}
+
+inline RgbLanes Lerp(const RgbLanes& a, const RgbLanes& b, Simd::F t) {
+    return { Simd::MulAdd(Simd::Sub(b.r, a.r), t, a.r),
+             Simd::MulAdd(Simd::Sub(b.g, a.g), t, a.g),
+             Simd::MulAdd(Simd::Sub(b.b, a.b), t, a.b) };
+}
+
+// --- Filters ---
+inline RgbLanes SampleNearest(const TextureView& tex, const LevelLanes& l, Simd::F s, Simd::F t) {
+    Simd::I x = WrapCoord(tex, Simd::Floor(Simd::Mul(s, l.fwidth)), l.fwidth);
+    Simd::I y = WrapCoord(tex, Simd::Floor(Simd::Mul(t, l.fheight)), l.fheight);
+    return FetchTexels(tex, TexelIndex(tex, l, x, y));
+}
+
+inline RgbLanes SampleBilinear(const TextureView& tex, const LevelLanes& l, Simd::F s, Simd::F t) {
+    const Simd::F half = Simd::Set(0.5f), one = Simd::Set(1.0f);
+    Simd::F fx = Simd::Sub(Simd::Mul(s, l.fwidth), half);
+    Simd::F fy = Simd::Sub(Simd::Mul(t, l.fheight), half);
+    Simd::F x0 = Simd::Floor(fx), y0 = Simd::Floor(fy);
+    Simd::F ax = Simd::Sub(fx, x0), ay = Simd::Sub(fy, y0);
+
+    Simd::I ix0 = WrapCoord(tex, x0, l.fwidth), ix1 = WrapCoord(tex, Simd::Add(x0, one), l.fwidth);
+    Simd::I iy0 = WrapCoord(tex, y0, l.fheight), iy1 = WrapCoord(tex, Simd::Add(y0, one), l.fheight);
+
+    RgbLanes c00 = FetchTexels(tex, TexelIndex(tex, l, ix0, iy0));
+    RgbLanes c10 = FetchTexels(tex, TexelIndex(tex, l, ix1, iy0));
+    RgbLanes c01 = FetchTexels(tex, TexelIndex(tex, l, ix0, iy1));
+    RgbLanes c11 = FetchTexels(tex, TexelIndex(tex, l, ix1, iy1));
+    return Lerp(Lerp(c00, c10, ax), Lerp(c01, c11, ax), ay);
+}
+
+// lod : mip level (fractional), clamped to the chain
+inline RgbLanes SampleLanes(const TextureView& tex, Simd::F s, Simd::F t, Simd::F lod) {
+    if (tex.filter == 0) return SampleNearest(tex, GatherLevel(tex, Simd::SetI(0)), s, t);
+
+    const Simd::F maxLevel = Simd::Set((float)(tex.levelCount - 1));
+    lod = Simd::Min(Simd::Max(lod, Simd::Set(0.0f)), maxLevel);
+
+    if (tex.filter == 1) {
+        // Bilinear on the nearest level
+        Simd::I level = Simd::Round(Simd::Floor(Simd::Add(lod, Simd::Set(0.5f))));
+        return SampleBilinear(tex, GatherLevel(tex, level), s, t);
+    }
+
+    // Trilinear
+    Simd::F base = Simd::Floor(lod);
+    Simd::F next = Simd::Min(Simd::Add(base, Simd::Set(1.0f)), maxLevel);
+    RgbLanes c0 = SampleBilinear(tex, GatherLevel(tex, Simd::Round(base)), s, t);
+    RgbLanes c1 = SampleBilinear(tex, GatherLevel(tex, Simd::Round(next)), s, t);
+    return Lerp(c0, c1, Simd::Sub(lod, base));
+}
+
+// log2 from the float bits (exponent + linear mantissa, max error 0.086) : enough for level selection
+inline Simd::F FastLog2(Simd::F x) {
+    return Simd::MulAdd(Simd::ToFloat(Simd::AsInt(x)), Simd::Set(1.0f / 8388608.0f), Simd::Set(-127.0f));
+}
+
+// --- Kernels ---
+void SampleTexture(const TextureView& texture, const float* u, const float* v, const float* lod, float* rgbOut, size_t count) {
+    const size_t W = Simd::Width;
+    float tmpU[Simd::Width], tmpV[Simd::Width], tmpLod[Simd::Width];
+    float r[Simd::Width], g[Simd::Width], b[Simd::Width];
+
+    for (size_t i = 0; i < count; i += W) {
+        size_t n = count - i < W ? count - i : W;
+        for (size_t j = 0; j < W; j++) {
+            size_t k = j < n ? i + j : i;
+            tmpU[j] = u[k]; tmpV[j] = v[k]; tmpLod[j] = lod[k];
+        }
+        RgbLanes c = SampleLanes(texture, Simd::Load(tmpU), Simd::Load(tmpV), Simd::Load(tmpLod));
+        Simd::Store(r, c.r); Simd::Store(g, c.g); Simd::Store(b, c.b);
+        for (size_t j = 0; j < n; j++) {
+            rgbOut[3 * (i + j) + 0] = r[j];
+            rgbOut[3 * (i + j) + 1] = g[j];
+            rgbOut[3 * (i + j) + 2] = b[j];
+        }
+    }
+}
+
+int RasterRowTextured(const RasterRowSetup& setup, const TexturedRowSetup& uv, const TextureView& texture,
+                      int count, float* depthRow, float* rgbRow, const float* tint, RasterRowStats* stats) {
+    static const float laneIndex[16] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+    const int W = Simd::Width;
+    const Simd::F lane = Simd::Load(laneIndex), zero = Simd::Set(0.0f);
+    const Simd::F fcount = Simd::Set((float)count);
+
+    // Derivatives in level 0 texels
+    const Simd::F texWidth = Simd::Set((float)texture.width[0]), texHeight = Simd::Set((float)texture.height[0]);
+
+    float depth[Simd::Width], z[Simd::Width], r[Simd::Width], g[Simd::Width], b[Simd::Width];
+    int written = 0;
+    for (int i = 0; i < count; i += W) {
+        Simd::F fi = Simd::Add(Simd::Set((float)i), lane);
+
+        // Edge Test (all three edges <= 0), lanes past the span end are masked out
+        // Unfused mul + add like RasterRow : edge pixels are owned the same way at every level
+        Simd::F e0 = Simd::Add(Simd::Mul(fi, Simd::Set(setup.dw0)), Simd::Set(setup.w0));
+        Simd::F e1 = Simd::Add(Simd::Mul(fi, Simd::Set(setup.dw1)), Simd::Set(setup.w1));
+        Simd::F e2 = Simd::Add(Simd::Mul(fi, Simd::Set(setup.dw2)), Simd::Set(setup.w2));
+        Simd::M inside = Simd::MAnd(Simd::MAnd(Simd::Le(e0, zero), Simd::Le(e1, zero)),
+                                    Simd::MAnd(Simd::Le(e2, zero), Simd::Lt(fi, fcount)));
+        unsigned int insideBits = Simd::MaskBits(inside);
+        if (insideBits == 0) continue;
+
+        // Depth Test
+        int n = count - i < W ? count - i : W;
+        for (int j = 0; j < W; j++) depth[j] = j < n ? depthRow[i + j] : 0.0f;
+        Simd::F zv = Simd::Add(Simd::Mul(fi, Simd::Set(setup.dz)), Simd::Set(setup.z));
+        unsigned int bits = Simd::MaskBits(Simd::MAnd(inside, Simd::Lt(zv, Simd::Load(depth))));
+        if (stats) CountRasterChunk(stats, i, insideBits, bits);
+        if (bits == 0) continue;
+
+        // Perspective correct uv : s = (u / w) / (1 / w)
+        Simd::F q = Simd::MulAdd(fi, Simd::Set(uv.dqdx), Simd::Set(uv.q));
+        Simd::F invQ = Simd::Div(Simd::Set(1.0f), q);
+        Simd::F s = Simd::Mul(Simd::MulAdd(fi, Simd::Set(uv.dudx), Simd::Set(uv.u)), invQ);
+        Simd::F t = Simd::Mul(Simd::MulAdd(fi, Simd::Set(uv.dvdx), Simd::Set(uv.v)), invQ);
+
+        // Screen space derivatives of (s, t) : d(U / Q) = (dU - s * dQ) / Q
+        Simd::F sx = Simd::Mul(Simd::Mul(Simd::Sub(Simd::Set(uv.dudx), Simd::Mul(s, Simd::Set(uv.dqdx))), invQ), texWidth);
+        Simd::F tx = Simd::Mul(Simd::Mul(Simd::Sub(Simd::Set(uv.dvdx), Simd::Mul(t, Simd::Set(uv.dqdx))), invQ), texHeight);
+        Simd::F sy = Simd::Mul(Simd::Mul(Simd::Sub(Simd::Set(uv.dudy), Simd::Mul(s, Simd::Set(uv.dqdy))), invQ), texWidth);
+        Simd::F ty = Simd::Mul(Simd::Mul(Simd::Sub(Simd::Set(uv.dvdy), Simd::Mul(t, Simd::Set(uv.dqdy))), invQ), texHeight);
+        Simd::F rhoSq = Simd::Max(Simd::MulAdd(sx, sx, Simd::Mul(tx, tx)), Simd::MulAdd(sy, sy, Simd::Mul(ty, ty)));
+        // lod = log2(rho), rho^2 is kept away from 0 (denormal bits are not a valid log)
+        Simd::F lod = Simd::Mul(FastLog2(Simd::Max(rhoSq, Simd::Set(1e-30f))), Simd::Set(0.5f));
+
+        RgbLanes c = SampleLanes(texture, s, t, lod);
+        Simd::Store(r, Simd::Mul(c.r, Simd::Set(tint[0])));
+        Simd::Store(g, Simd::Mul(c.g, Simd::Set(tint[1])));
+        Simd::Store(b, Simd::Mul(c.b, Simd::Set(tint[2])));
+        Simd::Store(z, zv);
+
+        for (; bits; bits &= bits - 1) {
+            int j = LowestBit(bits);
+            float* p = rgbRow + 3 * (i + j);
+            depthRow[i + j] = z[j];
+            p[0] = r[j]; p[1] = g[j]; p[2] = b[j];
+            written++;
+        }
+    }
+    return written;
+}
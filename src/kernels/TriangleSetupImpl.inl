@@ -0,0 +1,117 @@
+// Shared triangle setup kernel (Rasterizer::SetupTriangles).
+// Included by every Kernels_*.cpp inside its anonymous namespace, after the 8-lane wrapper `Lane8` is defined
+// (F : 8 floats, comparisons return F masks, LoadTransposed : x, y, z, w of 8 Vector3).
+// The signed area of 8 triangles is computed first : back facing & degenerate triangles only cost
+// their vertex loads, the bounding boxes & records are built for the survivors only.
+
+size_t SetupTriangles(const float* screen, const int32_t* triangles, size_t count, int width, int height,
+                      TriangleSetup* out, TriangleSetupCounts* counts) {
+    const Lane8::F zero = Lane8::Set(0.0f);
+    const Lane8::F half = Lane8::Set(0.5f);
+    const Lane8::F lastX = Lane8::Set((float)(width - 1));
+    const Lane8::F lastY = Lane8::Set((float)(height - 1));
+
+    alignas(32) float x[3][8], y[3][8], z[3][8], q[3][8];
+    alignas(32) float dwdx[3][8], dwdy[3][8];
+    alignas(32) float area[8], box[4][8];
+
+    TriangleSetupCounts c = { 0, 0, 0, 0 };
+    size_t written = 0;
+
+    for (size_t first = 0; first < count; first += 8) {
+        const size_t n = count - first < 8 ? count - first : 8;
+
+        // Tail lanes repeat the last triangle (masked out below)
+        const float* v[3][8];
+        for (size_t lane = 0; lane < 8; lane++) {
+            const int32_t* tri = triangles + 3 * (first + (lane < n ? lane : n - 1));
+            v[0][lane] = screen + 4 * tri[0];
+            v[1][lane] = screen + 4 * tri[1];
+            v[2][lane] = screen + 4 * tri[2];
+        }
+
+        Lane8::F X[3], Y[3], Z[3], Q[3];
+        for (int k = 0; k < 3; k++) Lane8::LoadTransposed(v[k], X[k], Y[k], Z[k], Q[k]);
+
+        // Signed area, same expression as the scalar EdgeFunction(v0, v1, v2)
+        Lane8::F A = Lane8::Sub(Lane8::Mul(Lane8::Sub(X[2], X[0]), Lane8::Sub(Y[1], Y[0])),
+                                Lane8::Mul(Lane8::Sub(Y[2], Y[0]), Lane8::Sub(X[1], X[0])));
+
+        const unsigned int valid = (1u << n) - 1;
+        const unsigned int zeroArea = Lane8::MaskBits(Lane8::Eq(A, zero)) & valid;
+        const unsigned int backface = Lane8::MaskBits(Lane8::Gt(A, zero)) & valid;
+        unsigned int alive = Lane8::MaskBits(Lane8::Lt(A, zero)) & valid;
+        c.zeroArea += (uint32_t)PopCount(zeroArea);
+        c.backface += (uint32_t)PopCount(backface);
+
+        // NaN coordinates : nothing to draw, counted as off-target
+        unsigned int frustum = valid & ~(zeroArea | backface | alive);
+
+        if (alive != 0) {
+            Lane8::F minX = Lane8::Min(Lane8::Min(X[0], X[1]), X[2]);
+            Lane8::F minY = Lane8::Min(Lane8::Min(Y[0], Y[1]), Y[2]);
+            Lane8::F maxX = Lane8::Max(Lane8::Max(X[0], X[1]), X[2]);
+            Lane8::F maxY = Lane8::Max(Lane8::Max(Y[0], Y[1]), Y[2]);
+
+            // Pixel bounding box, clipped in float (no int overflow on huge coordinates)
+            Lane8::F bx0 = Lane8::Max(Lane8::Floor(minX), zero);
+            Lane8::F by0 = Lane8::Max(Lane8::Floor(minY), zero);
+            Lane8::F bx1 = Lane8::Min(Lane8::Ceil(maxX), lastX);
+            Lane8::F by1 = Lane8::Min(Lane8::Ceil(maxY), lastY);
+            unsigned int outside = Lane8::MaskBits(Lane8::Or(Lane8::Gt(bx0, bx1), Lane8::Gt(by0, by1))) & alive;
+            frustum |= outside;
+            alive &= ~outside;
+
+            // Sub-pixel : no pixel centre (k + 0.5) between min & max on one of the axes
+            Lane8::F cx0 = Lane8::Ceil(Lane8::Sub(minX, half)), cx1 = Lane8::Floor(Lane8::Sub(maxX, half));
+            Lane8::F cy0 = Lane8::Ceil(Lane8::Sub(minY, half)), cy1 = Lane8::Floor(Lane8::Sub(maxY, half));
+            unsigned int subPixel = Lane8::MaskBits(Lane8::Or(Lane8::Gt(cx0, cx1), Lane8::Gt(cy0, cy1))) & alive;
+            c.subPixel += (uint32_t)PopCount(subPixel);
+            alive &= ~subPixel;
+
+            if (alive != 0) {
+                for (int k = 0; k < 3; k++) {
+                    Lane8::Store(x[k], X[k]);
+                    Lane8::Store(y[k], Y[k]);
+                    Lane8::Store(z[k], Z[k]);
+                    Lane8::Store(q[k], Q[k]);
+                }
+                // Edge steps (origins v1, v2, v0)
+                Lane8::Store(dwdx[0], Lane8::Sub(Y[2], Y[1])); Lane8::Store(dwdy[0], Lane8::Sub(X[1], X[2]));
+                Lane8::Store(dwdx[1], Lane8::Sub(Y[0], Y[2])); Lane8::Store(dwdy[1], Lane8::Sub(X[2], X[0]));
+                Lane8::Store(dwdx[2], Lane8::Sub(Y[1], Y[0])); Lane8::Store(dwdy[2], Lane8::Sub(X[0], X[1]));
+                Lane8::Store(area, A);
+                Lane8::Store(box[0], bx0); Lane8::Store(box[1], by0);
+                Lane8::Store(box[2], bx1); Lane8::Store(box[3], by1);
+
+                for (; alive; alive &= alive - 1) {
+                    const int lane = LowestBit(alive);
+                    TriangleSetup& s = out[written++];
+                    for (int k = 0; k < 3; k++) {
+                        s.x[k] = x[k][lane];
+                        s.y[k] = y[k][lane];
+                        s.z[k] = z[k][lane];
+                        s.q[k] = q[k][lane];
+                        s.dwdx[k] = dwdx[k][lane];
+                        s.dwdy[k] = dwdy[k][lane];
+                    }
+                    s.area = area[lane];
+                    s.minX = (int32_t)box[0][lane];
+                    s.minY = (int32_t)box[1][lane];
+                    s.maxX = (int32_t)box[2][lane];
+                    s.maxY = (int32_t)box[3][lane];
+                    s.triangle = (uint32_t)(first + lane);
+                }
+            }
+        }
+        c.frustum += (uint32_t)PopCount(frustum);
+    }
+
+    if (counts) {
+        counts->zeroArea += c.zeroArea;
+        counts->backface += c.backface;
+        counts->frustum += c.frustum;
+        counts->subPixel += c.subPixel;
+    }
+    return written;
+}
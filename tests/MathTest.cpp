@@ -1,6 +1,9 @@
 #include <iostream>
 #include <cstdio>
 #include <cmath> 
+#include <thread>
+#include <fstream>
+#include <filesystem>
 #include "../include/Common.h"
 #include "../include/Canvas.h"
 #include "../include/Vector3.h" 
@@ -8,9 +11,27 @@
 #include "../include/Quaternion.h"
 #include "../include/Mesh.h"
 #include "../include/Rasterizer.h"
+#include "../include/CpuDispatch.h"
+#include "../include/RenderStats.h"
+#include "../include/FrameArena.h"
+#include "../include/PackedVertex.h"
+#include "../include/SimdMath.h"
+#include "../include/Bvh.h"
+#include "../include/Texture.h"
+#include "../include/CommandBuffer.h"
+#include "../include/FramePipeline.h"
 
 using namespace Shika;
 
+// "(expected ...)" checks : every failure is reported, TestApp exits with 1 if any failed
+static int failures = 0;
+
+static void Check(bool ok, const char* what) {
+    if (ok) return;
+    failures++;
+    printf("FAILED: %s\n", what);
+}
+
 int main() {
 /*
     const int width = 400;
@@ -80,5 +101,614 @@ int main() {
     printf("Normalized Vector(3.0f, 4.0f, 0.0f): x=%.7f, y=%.7f, z=%.7f\n", norm.x, norm.y, norm.z);
     printf("NormalizedFast Vector(3.0f, 4.0f, 0.0f): x=%.7f, y=%.7f, z=%.7f\n", normFast.x, normFast.y, normFast.z);
 
-    return 0;
+    printf("\n=== CPU Dispatch Test ===\n");
+    SimdLevel detected = DetectSimdLevel();
+    printf("Detected: %s, Selected: %s\n", SimdLevelName(detected), SimdLevelName(GetSimdLevel()));
+
+    Matrix4x4 mvp = Matrix4x4::RotationY(ToRadian(30)) * Matrix4x4::Translation(Vector3(0, 0, 5.0f))
+                  * Matrix4x4::PerspectiveFovLH(ToRadian(60), 4.0f / 3.0f, 0.1f, 100.0f);
+    Vector3 points[5] = { {-1, 1, -1}, {1, 1, -1}, {-1, -1, 1}, {1, -1, 1}, {0.5f, 0.25f, 0} };
+    float rgbIn[17 * 3];
+    for (int i = 0; i < 17 * 3; i++) rgbIn[i] = -0.25f + i * 0.03f;
+
+    for (int level = 0; level <= (int)detected; level++) {
+        const KernelTable& k = GetKernels((SimdLevel)level);
+
+        // Batch Projection vs TransformVertex
+        Vector3 projected[5];
+        k.ProjectVertices(points[0].e, projected[0].e, 5, mvp.e, 400, 300);
+        float maxErr = 0.0f;
+        for (int i = 0; i < 5; i++) {
+            Vector3 ref = Rasterizer::TransformVertex(points[i], mvp, 400, 300);
+            maxErr = std::max(maxErr, std::fabs(ref.x - projected[i].x) + std::fabs(ref.y - projected[i].y) + std::fabs(ref.z - projected[i].z));
+        }
+
+        // Raster Row : 37 pixels, covered in [10, 30], depth ramp passes below x = 25.5
+        RasterRowSetup row = { 10.0f, -30.0f, -1.0f, -1.0f, 1.0f, 0.0f, 0.0f, 0.02f };
+        float depth[37], rgb[37 * 3] = {};
+        for (int i = 0; i < 37; i++) depth[i] = 0.51f;
+        const float orange[3] = { 1.0f, 0.5f, 0.0f };
+        RasterRowStats rowStats = { 0, nullptr };
+        int written = k.RasterRow(row, 37, depth, rgb, orange, &rowStats);
+
+        // Framebuffer Conversion
+        uint8_t rgb8[17 * 3];
+        k.ConvertRGB8(rgbIn, rgb8, 17);
+        bool convertOk = true;
+        for (int i = 0; i < 17 * 3; i++) {
+            int ref = static_cast<int>(std::clamp(rgbIn[i], 0.0f, 1.0f) * 255.99f);
+            if (rgb8[i] != ref) convertOk = false;
+        }
+
+        printf("[%s] Project max error: %.6f, RasterRow written: %d (expected 16), covered: %u (expected 21), ConvertRGB8: %s\n",
+               SimdLevelName((SimdLevel)level), maxErr, written, rowStats.covered, convertOk ? "OK" : "FAIL");
+        Check(written == 16 && rowStats.covered == 21 && convertOk, "dispatch kernels");
+    }
+
+    // Pixels exactly on edge 0 (w0 + i * dw0 == 0 without fusion) : every level owns the same pixels
+    {
+        uint32_t covered[3] = {};
+        for (int level = 0; level <= (int)detected; level++) {
+            for (int r = 0; r < 64; r++) {
+                float dw = 0.1f + r * 0.0137f;
+                RasterRowSetup edgeRow = { -(float)(r % 29) * dw, -1.0f, -1.0f, dw, 0.0f, 0.0f, 0.5f, 0.0f };
+                float depth[37], rgb[37 * 3];
+                for (int i = 0; i < 37; i++) depth[i] = 1.0f;
+                const float white[3] = { 1.0f, 1.0f, 1.0f };
+                RasterRowStats rowStats = { 0, nullptr };
+                GetKernels((SimdLevel)level).RasterRow(edgeRow, 37, depth, rgb, white, &rowStats);
+                covered[level] += rowStats.covered;
+            }
+        }
+        printf("Edge pixels covered: %u %u %u (expected equal)\n", covered[0], covered[1], covered[2]);
+        for (int level = 1; level <= (int)detected; level++) Check(covered[level] == covered[0], "edge ownership across levels");
+    }
+
+    printf("\n=== Packed Vertex Test ===\n");
+    {
+        // 13 vertices : exercises the full-width loops and every tail size
+        const int count = 13;
+        std::vector<PackedFloat3> packed(count);
+        std::vector<Half3> halfs(count);
+        std::vector<PackedNormal> normals(count);
+        std::vector<Vector3> source(count);
+        for (int i = 0; i < count; i++) {
+            source[i] = Vector3(std::sin(i * 1.3f) * 50.0f, std::cos(i * 0.7f) * 0.01f, -3.0f + i * 1e-5f);
+            packed[i] = PackFloat3(source[i]);
+            halfs[i] = PackHalf3(source[i]);
+            normals[i] = PackNormal(source[i].Normalized());
+        }
+
+        for (int level = 0; level <= (int)detected; level++) {
+            const KernelTable& k = GetKernels((SimdLevel)level);
+            std::vector<Vector3> outFloat(count), outHalf(count), outNormal(count);
+            k.DecodeFloat3(&packed[0].x, outFloat[0].e, count);
+            k.DecodeHalf3(&halfs[0].x, outHalf[0].e, count);
+            k.DecodeNormals(&normals[0].bits, outNormal[0].e, count);
+
+            int mismatches = 0;
+            for (int i = 0; i < count; i++) {
+                Vector3 refHalf = UnpackHalf3(halfs[i]);
+                Vector3 refNormal = UnpackNormal(normals[i]);
+                for (int c = 0; c < 4; c++) {
+                    if (outFloat[i].e[c] != source[i].e[c]) mismatches++;
+                    if (outHalf[i].e[c] != (c < 3 ? refHalf.e[c] : 0.0f)) mismatches++;
+                    if (outNormal[i].e[c] != (c < 3 ? refNormal.e[c] : 0.0f)) mismatches++;
+                }
+            }
+            printf("[%s] Decode mismatches: %d (expected 0)\n", SimdLevelName((SimdLevel)level), mismatches);
+            Check(mismatches == 0, "packed vertex decode");
+        }
+
+        Mesh cube = Mesh::CreateCube();
+        size_t alignedBytes = cube.vertices.size() * sizeof(Vector3);
+        cube.SetPositionFormat(VertexFormat::Half3);
+        printf("Cube positions: %zu bytes -> %zu bytes (Half3)\n", alignedBytes, cube.halfVertices.size() * sizeof(Half3));
+        printf("HalfToFloat(FloatToHalf(0.1f)) = %.7f\n", HalfToFloat(FloatToHalf(0.1f)));
+    }
+
+    printf("\n=== Frame Arena Test ===\n");
+    {
+        Canvas canvas(160, 120);
+        Mesh cube = Mesh::CreateCube();
+        FrameArena arena(1, 4096);
+
+        size_t firstFrameBlocks = 0;
+        for (int frame = 0; frame < 3; frame++) {
+            LinearArena& local = arena.Thread(0);
+            Rasterizer::DrawMesh(canvas, cube, mvp, Color::White(), local);
+
+            // Transient array bigger than the first block (forces one overflow in frame 0)
+            ArenaVector<int> temp{ ArenaAllocator<int>(local) };
+            for (int i = 0; i < 4000; i++) temp.push_back(i);
+
+            printf("Frame %d: used %zu / %zu bytes, heap blocks %zu\n", frame, local.Used(), local.Capacity(), local.BlockAllocations());
+            arena.Reset();
+            if (frame == 0) firstFrameBlocks = local.BlockAllocations();
+        }
+        // Steady state : frames after the first reuse the grown arena
+        Check(arena.Thread(0).BlockAllocations() == firstFrameBlocks, "no heap blocks after the first frame");
+    }
+
+    printf("\n=== SIMD Math Test ===\n");
+    {
+        // Error in units of the last place of the float result
+        auto ulp = [](float value, double ref) -> double {
+            if (ref == 0.0) return value == 0.0f ? 0.0 : 1e9;
+            int e;
+            std::frexp(ref, &e);
+            return std::fabs((double)value - ref) / std::ldexp(1.0, std::max(e, -125) - 24);
+        };
+
+        // 1001 samples : full-width loops + tail
+        const int count = 1001;
+        std::vector<float> x(count), unit(count), y(count), pos(count);
+        for (int i = 0; i < count; i++) {
+            x[i] = (i - 500) * 0.0137f * (i % 7 + 1);
+            unit[i] = -1.0f + 2.0f * i / (count - 1);
+            y[i] = std::sin(i * 0.37f) * (i % 5 + 1);
+            pos[i] = std::ldexp(1.0f + (i % 97) / 97.0f, i % 60 - 30);
+        }
+
+        for (int level = 0; level <= (int)detected; level++) {
+            const KernelTable& k = GetKernels((SimdLevel)level);
+            std::vector<float> s(count), c(count), t(count), a(count), ac(count), e(count), r(count);
+            k.SinCos(x.data(), s.data(), c.data(), count);
+            k.Tan(x.data(), t.data(), count);
+            k.Atan2(y.data(), x.data(), a.data(), count);
+            k.Acos(unit.data(), ac.data(), count);
+            k.Exp(y.data(), e.data(), count);
+            k.Rsqrt(pos.data(), r.data(), count);
+
+            double errSinCos = 0, errTan = 0, errAtan2 = 0, errAcos = 0, errExp = 0, errRsqrt = 0;
+            for (int i = 0; i < count; i++) {
+                errSinCos = std::max({ errSinCos, ulp(s[i], std::sin((double)x[i])), ulp(c[i], std::cos((double)x[i])) });
+                errTan = std::max(errTan, ulp(t[i], std::tan((double)x[i])));
+                errAtan2 = std::max(errAtan2, ulp(a[i], std::atan2((double)y[i], (double)x[i])));
+                errAcos = std::max(errAcos, ulp(ac[i], std::acos((double)unit[i])));
+                errExp = std::max(errExp, ulp(e[i], std::exp((double)y[i])));
+                errRsqrt = std::max(errRsqrt, ulp(r[i], 1.0 / std::sqrt((double)pos[i])));
+            }
+            printf("[%s] Max ULP sincos %.2f (<=3), tan %.2f (<=4), atan2 %.2f (<=4), acos %.2f (<=2), exp %.2f (<=2), rsqrt %.2f (<=3)\n",
+                   SimdLevelName((SimdLevel)level), errSinCos, errTan, errAtan2, errAcos, errExp, errRsqrt);
+            Check(errSinCos <= 3 && errTan <= 4 && errAtan2 <= 4 && errAcos <= 2 && errExp <= 2 && errRsqrt <= 3, "SIMD math ULP bounds");
+        }
+
+        // Batch constructors vs scalar
+        std::vector<Matrix4x4> rotBatch(count);
+        std::vector<Quaternion> quatBatch(count);
+        std::vector<Vector3> axes(count);
+        for (int i = 0; i < count; i++) axes[i] = Vector3(std::sin(i * 1.1f), 1.0f, std::cos(i * 0.3f));
+
+        Matrix4x4::RotationYBatch(x.data(), rotBatch.data(), count);
+        Quaternion::RotationAxisBatch(axes.data(), x.data(), quatBatch.data(), count);
+        float maxMatErr = 0.0f, maxQuatErr = 0.0f;
+        for (int i = 0; i < count; i++) {
+            Matrix4x4 ref = Matrix4x4::RotationY(x[i]);
+            for (int j = 0; j < 16; j++) maxMatErr = std::max(maxMatErr, std::fabs(ref.e[j] - rotBatch[i].e[j]));
+            Quaternion q = Quaternion::RotationAxis(axes[i], x[i]);
+            maxQuatErr = std::max({ maxQuatErr, std::fabs(q.x - quatBatch[i].x), std::fabs(q.y - quatBatch[i].y),
+                                    std::fabs(q.z - quatBatch[i].z), std::fabs(q.w - quatBatch[i].w) });
+        }
+
+        Quaternion::RotationYawPitchRollBatch(y.data(), x.data(), unit.data(), quatBatch.data(), count);
+        float maxYprErr = 0.0f;
+        for (int i = 0; i < count; i++) {
+            Quaternion q = Quaternion::RotationYawPitchRoll(y[i], x[i], unit[i]);
+            maxYprErr = std::max({ maxYprErr, std::fabs(q.x - quatBatch[i].x), std::fabs(q.y - quatBatch[i].y),
+                                   std::fabs(q.z - quatBatch[i].z), std::fabs(q.w - quatBatch[i].w) });
+        }
+        printf("Batch vs scalar max error: RotationY %.2e, RotationAxis %.2e, YawPitchRoll %.2e\n", maxMatErr, maxQuatErr, maxYprErr);
+    }
+
+    printf("\n=== BVH Test ===\n");
+    {
+        // 3 x 3 x 3 grid of cubes (324 triangles), spacing 4
+        Mesh grid;
+        Mesh cube = Mesh::CreateCube();
+        for (int i = 0; i < 27; i++) {
+            Vector3 offset((i % 3 - 1) * 4.0f, (i / 3 % 3 - 1) * 4.0f, (i / 9 - 1) * 4.0f);
+            int base = (int)grid.vertices.size();
+            for (const auto& v : cube.vertices) grid.vertices.push_back(v + offset);
+            for (const auto& tri : cube.indices) grid.indices.push_back({ tri[0] + base, tri[1] + base, tri[2] + base });
+        }
+
+        Bvh bvh(grid);
+        Bvh bvhThreaded(grid, 4);
+        printf("Triangles: %zu, Nodes: %zu, Leaves: %zu (threaded build: %zu / %zu)\n",
+               bvh.TriangleCount(), bvh.NodeCount(), bvh.LeafCount(), bvhThreaded.NodeCount(), bvhThreaded.LeafCount());
+
+        // Ray packet, the grid spans [-5, 5]
+        BvhRay rays[4] = {
+            Bvh::MakeRay(Vector3(0, 0, -10), Vector3(0, 0, 1)),                 // first face z = -5, t = 5
+            Bvh::MakeRay(Vector3(4, -4, 10), Vector3(0, 0, -2)),                // first face z = 5, t = 2.5
+            Bvh::MakeRay(Vector3(2, 2, -10), Vector3(0, 0, 1)),                 // between the cubes : miss
+            Bvh::MakeRay(Vector3(-10, 0.5f, 0.5f), Vector3(1, 0, 0), 0.0f, 4.0f) // first face x = -5 is beyond tMax
+        };
+
+        for (int level = 0; level <= (int)detected; level++) {
+            const KernelTable& k = GetKernels((SimdLevel)level);
+            BvhHit hits[4];
+            uint8_t occluded[4];
+            k.IntersectRays(bvh.View(), rays, hits, 4);
+            k.OccludedRays(bvh.View(), rays, occluded, 4);
+            printf("[%s] t: %.3f %.3f, triangles: %d %d %d %d (expected -1 for the last two), occluded: %d %d %d %d (expected 1 1 0 0)\n",
+                   SimdLevelName((SimdLevel)level), hits[0].t, hits[1].t, hits[0].triangle, hits[1].triangle, hits[2].triangle, hits[3].triangle,
+                   occluded[0], occluded[1], occluded[2], occluded[3]);
+            Check(std::fabs(hits[0].t - 5.0f) < 1e-4f && std::fabs(hits[1].t - 2.5f) < 1e-4f && hits[0].triangle >= 0 && hits[1].triangle >= 0 &&
+                  hits[2].triangle == -1 && hits[3].triangle == -1, "BVH closest hit");
+            Check(occluded[0] == 1 && occluded[1] == 1 && occluded[2] == 0 && occluded[3] == 0, "BVH occlusion");
+        }
+
+        // 8 x 8 x 8 cubes (6144 triangles) : above the parallel threshold, the threaded build must match
+        Mesh big;
+        for (int i = 0; i < 512; i++) {
+            Vector3 offset((i % 8 - 3.5f) * 3.0f, (i / 8 % 8 - 3.5f) * 3.0f, (i / 64 - 3.5f) * 3.0f);
+            int base = (int)big.vertices.size();
+            for (const auto& v : cube.vertices) big.vertices.push_back(v + offset);
+            for (const auto& tri : cube.indices) big.indices.push_back({ tri[0] + base, tri[1] + base, tri[2] + base });
+        }
+        Bvh bigSingle(big);
+        Bvh bigThreaded(big, 4);
+
+        const int rayCount = 256;
+        std::vector<BvhRay> bigRays(rayCount);
+        for (int i = 0; i < rayCount; i++) {
+            Vector3 origin(std::sin(i * 0.7f) * 30.0f, std::cos(i * 1.3f) * 30.0f, -40.0f);
+            bigRays[i] = Bvh::MakeRay(origin, Vector3(std::sin(i * 0.37f) * 10.0f, std::cos(i * 0.59f) * 10.0f, 0.0f) - origin);
+        }
+        std::vector<BvhHit> hitsSingle(rayCount), hitsThreaded(rayCount);
+        bigSingle.Intersect(bigRays.data(), hitsSingle.data(), rayCount);
+        bigThreaded.Intersect(bigRays.data(), hitsThreaded.data(), rayCount);
+        int bigHits = 0, bigMismatches = 0;
+        for (int i = 0; i < rayCount; i++) {
+            if (hitsSingle[i].triangle >= 0) bigHits++;
+            if (hitsSingle[i].triangle != hitsThreaded[i].triangle || hitsSingle[i].t != hitsThreaded[i].t) bigMismatches++;
+        }
+        printf("Threaded build (%zu triangles) : nodes %zu / %zu, leaves %zu / %zu, hits %d, mismatches %d (expected 0)\n",
+               big.indices.size(), bigSingle.NodeCount(), bigThreaded.NodeCount(), bigSingle.LeafCount(), bigThreaded.LeafCount(), bigHits, bigMismatches);
+        Check(bigSingle.NodeCount() == bigThreaded.NodeCount() && bigSingle.LeafCount() == bigThreaded.LeafCount() &&
+              bigHits > 0 && bigMismatches == 0, "threaded BVH build");
+    }
+
+    printf("\n=== Texture Test ===\n");
+    {
+        // Non power of two, 6 mip levels
+        std::vector<Color> texels(37 * 21);
+        for (int i = 0; i < 37 * 21; i++) texels[i] = { (i % 37) / 36.0f, (i / 37) / 20.0f, (i % 7) / 6.0f };
+        Texture rowMajor(37, 21, texels, TextureLayout::RowMajor);
+        Texture morton(37, 21, texels, TextureLayout::Morton);
+        rowMajor.GenerateMips();
+        morton.GenerateMips();
+
+        const int count = 203;
+        std::vector<float> u(count), v(count), lod(count);
+        for (int i = 0; i < count; i++) {
+            u[i] = std::sin(i * 0.91f) * 1.7f;
+            v[i] = std::cos(i * 0.37f) * 1.3f;
+            lod[i] = (i % 13) * 0.5f - 1.0f;
+        }
+
+        for (int level = 0; level <= (int)detected; level++) {
+            const KernelTable& k = GetKernels((SimdLevel)level);
+            float maxErr = 0.0f, layoutErr = 0.0f;
+            for (int filter = 0; filter < 3; filter++) {
+                for (int wrap = 0; wrap < 2; wrap++) {
+                    rowMajor.SetFilter((TextureFilter)filter); rowMajor.SetWrap((TextureWrap)wrap);
+                    morton.SetFilter((TextureFilter)filter); morton.SetWrap((TextureWrap)wrap);
+
+                    std::vector<Color> outRowMajor(count), outMorton(count);
+                    k.SampleTexture(rowMajor.View(), u.data(), v.data(), lod.data(), &outRowMajor[0].r, count);
+                    k.SampleTexture(morton.View(), u.data(), v.data(), lod.data(), &outMorton[0].r, count);
+                    for (int i = 0; i < count; i++) {
+                        Color ref = rowMajor.Sample(u[i], v[i], lod[i]);
+                        maxErr = std::max({ maxErr, std::fabs(ref.r - outRowMajor[i].r), std::fabs(ref.g - outRowMajor[i].g), std::fabs(ref.b - outRowMajor[i].b) });
+                        layoutErr = std::max({ layoutErr, std::fabs(outMorton[i].r - outRowMajor[i].r), std::fabs(outMorton[i].b - outRowMajor[i].b) });
+                    }
+                }
+            }
+            printf("[%s] Sample vs scalar max error: %.2e, Morton vs RowMajor: %.2e (expected 0)\n", SimdLevelName((SimdLevel)level), maxErr, layoutErr);
+            Check(layoutErr == 0.0f, "Morton vs RowMajor sampling");
+            Check(maxErr < 1e-4f, "texture kernel vs scalar Sample");
+        }
+        printf("Levels: %d, RowMajor: %zu bytes, Morton: %zu bytes\n", rowMajor.LevelCount(), rowMajor.SizeInBytes(), morton.SizeInBytes());
+
+        // Default layout : Morton only when it needs no padding
+        Texture npot(37, 21, texels);
+        Texture pot = Texture::Checkerboard(64, 4, Color::White(), Color::Red());
+        printf("Auto layout : 37x21 %s, 64x64 %s\n", npot.Layout() == TextureLayout::RowMajor ? "RowMajor" : "Morton",
+               pot.Layout() == TextureLayout::Morton ? "Morton" : "RowMajor");
+        Check(npot.Layout() == TextureLayout::RowMajor && pot.Layout() == TextureLayout::Morton, "auto texture layout");
+
+        // Textured cube : perspective correct uv, per pixel mip selection
+        Texture checker = Texture::Checkerboard(256, 8, Color::White(), Color::Red());
+        checker.GenerateMips();
+        Mesh cube = Mesh::CreateCube();
+        for (const auto& p : cube.vertices) cube.uvs.push_back(PackHalf2(p.x * 0.5f + 0.5f, p.y * 0.5f + 0.5f));
+
+        Canvas canvas(160, 120);
+        FrameArena arena(1, 4096);
+        Rasterizer::DrawMesh(canvas, cube, mvp, checker, Color::White(), arena.Thread(0));
+        int red = 0, white = 0;
+        const Color* pixels = canvas.PixelData();
+        for (int i = 0; i < 160 * 120; i++) {
+            if (pixels[i].r > 0.9f && pixels[i].g < 0.1f) red++;
+            if (pixels[i].r > 0.9f && pixels[i].g > 0.9f) white++;
+        }
+        printf("Textured cube : red %d px, white %d px\n", red, white);
+        // Half of the checks of each face are red
+        Check(red > 100 && white > 100 && std::abs(red - white) <= (red + white) / 10, "textured cube checkerboard");
+    }
+
+    printf("\n=== Triangle Setup Test ===\n");
+    {
+        // Random triangles (both windings), plus degenerate, off-canvas & sub-pixel ones
+        const int count = 203, width = 160, height = 120;
+        std::vector<Vector3> screen(3 * count);
+        std::vector<std::array<int, 3>> triangles(count);
+        for (int i = 0; i < count; i++) {
+            float cx = 80.0f + 70.0f * std::sin(i * 1.7f), cy = 60.0f + 50.0f * std::cos(i * 0.9f);
+            float r = (i % 7 == 0) ? 0.2f : 4.0f + (i % 5) * 6.0f;
+            if (i % 13 == 0) cx += 400.0f;
+            for (int k = 0; k < 3; k++) {
+                float a = i * 0.37f + (i % 2 ? -k : k) * 2.1f;
+                screen[3 * i + k] = Vector3(cx + r * std::cos(a), cy + r * std::sin(a), 0.5f);
+                screen[3 * i + k].e[3] = 1.0f;
+            }
+            if (i % 11 == 0) screen[3 * i + 2] = screen[3 * i + 1];
+            triangles[i] = { 3 * i, 3 * i + 1, 3 * i + 2 };
+        }
+
+        // Scalar reference of the culling rules
+        std::vector<int> expected;
+        for (int i = 0; i < count; i++) {
+            const Vector3& a = screen[3 * i]; const Vector3& b = screen[3 * i + 1]; const Vector3& c = screen[3 * i + 2];
+            float area = (c.x - a.x) * (b.y - a.y) - (c.y - a.y) * (b.x - a.x);
+            float minX = std::min({ a.x, b.x, c.x }), maxX = std::max({ a.x, b.x, c.x });
+            float minY = std::min({ a.y, b.y, c.y }), maxY = std::max({ a.y, b.y, c.y });
+            bool outside = std::max(std::floor(minX), 0.0f) > std::min(std::ceil(maxX), width - 1.0f) ||
+                           std::max(std::floor(minY), 0.0f) > std::min(std::ceil(maxY), height - 1.0f);
+            bool subPixel = std::ceil(minX - 0.5f) > std::floor(maxX - 0.5f) || std::ceil(minY - 0.5f) > std::floor(maxY - 0.5f);
+            if (area < 0 && !outside && !subPixel) expected.push_back(i);
+        }
+
+        for (int level = 0; level <= (int)detected; level++) {
+            const KernelTable& k = GetKernels((SimdLevel)level);
+            std::vector<TriangleSetup> setups(count);
+            TriangleSetupCounts counts = { 0, 0, 0, 0 };
+            size_t visible = k.SetupTriangles(screen[0].e, &triangles[0][0], count, width, height, setups.data(), &counts);
+
+            int mismatches = 0;
+            for (size_t i = 0; i < visible && i < expected.size(); i++) {
+                const TriangleSetup& s = setups[i];
+                const Vector3& v0 = screen[3 * s.triangle];
+                if ((int)s.triangle != expected[i] || s.minX != std::max((int)std::floor(std::min({ v0.x, screen[3 * s.triangle + 1].x, screen[3 * s.triangle + 2].x })), 0)) mismatches++;
+            }
+            size_t culled = counts.zeroArea + counts.backface + counts.frustum + counts.subPixel;
+            printf("[%s] visible: %zu (expected %zu), zero area: %u, backface: %u, frustum: %u, sub-pixel: %u, total: %zu (expected %d), mismatches: %d\n",
+                   SimdLevelName((SimdLevel)level), visible, expected.size(), counts.zeroArea, counts.backface, counts.frustum, counts.subPixel,
+                   visible + culled, count, mismatches);
+            Check(visible == expected.size() && visible + culled == (size_t)count && mismatches == 0, "triangle setup vs scalar");
+        }
+
+        // Closed mesh : the back half costs only the area test
+        Mesh cube = Mesh::CreateCube();
+        Canvas canvas(400, 300);
+        FrameArena arena(1, 4096);
+        Vector3* projected = Rasterizer::ProjectMesh(canvas, cube, mvp, arena.Thread(0));
+        TriangleSetup setups[12];
+        size_t visible = Rasterizer::SetupTriangles(canvas, projected, cube.indices.data(), cube.indices.size(), setups);
+        int front = 0;
+        for (const auto& tri : cube.indices) {
+            const Vector3& a = projected[tri[0]]; const Vector3& b = projected[tri[1]]; const Vector3& c = projected[tri[2]];
+            if ((c.x - a.x) * (b.y - a.y) - (c.y - a.y) * (b.x - a.x) < 0) front++;
+        }
+        printf("Cube : %zu of 12 triangles visible (expected %d)\n", visible, front);
+        Check(visible == (size_t)front, "cube front faces");
+    }
+
+    printf("\n=== Command Buffer Test ===\n");
+    {
+        // 5x5x4 cubes submitted back to front (worst case for immediate drawing), 2 materials
+        Mesh cube = Mesh::CreateCube();
+        Matrix4x4 proj = Matrix4x4::PerspectiveFovLH(ToRadian(60), 4.0f / 3.0f, 0.1f, 100.0f);
+        std::vector<Matrix4x4> transforms;
+        for (int z = 3; z >= 0; z--)
+            for (int y = -2; y <= 2; y++)
+                for (int x = -2; x <= 2; x++)
+                    transforms.push_back(Matrix4x4::RotationY(0.3f * (x + y)) * Matrix4x4::Translation(Vector3(x * 2.5f, y * 2.5f, 10.0f + z * 3.0f)) * proj);
+
+        Canvas immediate(160, 120), sorted(160, 120);
+        FrameArena arena(1, 1 << 16);
+        for (size_t i = 0; i < transforms.size(); i++) {
+            Rasterizer::DrawMesh(immediate, cube, transforms[i], (i & 1) ? Color::Red() : Color::Green(), arena.Thread(0));
+        }
+
+        CommandBuffer commands;
+        int red = commands.AddMaterial(Color::Red());
+        int green = commands.AddMaterial(Color::Green());
+        for (size_t i = 0; i < transforms.size(); i++) {
+            commands.Submit(cube, transforms[i], (i & 1) ? red : green);
+        }
+        commands.SubmitTriangle({ 8, 8, 0.01f }, { 40, 8, 0.01f }, { 8, 40, 0.01f }, red);
+        commands.SubmitTriangle({ 8, 8, 0.01f }, { 40, 8, 0.01f }, { 8, 40, 0.01f }, red);
+        Rasterizer::DrawFilledTriangle(immediate, { 8, 8, 0.01f }, { 40, 8, 0.01f }, { 8, 40, 0.01f }, Color::Red());
+
+    #if defined(SHIKA_ENABLE_STATS)
+        Stats::BeginFrame();
+    #endif
+        arena.Reset();
+        commands.Execute(sorted, arena.Thread(0));
+    #if defined(SHIKA_ENABLE_STATS)
+        RenderStats sortedStats = Stats::EndFrame();
+    #endif
+
+        int mismatches = 0;
+        for (int i = 0; i < 160 * 120; i++) {
+            const Color& a = immediate.PixelData()[i];
+            const Color& b = sorted.PixelData()[i];
+            if (a.r != b.r || a.g != b.g || a.b != b.b) mismatches++;
+        }
+        printf("Draws: %zu, loose: %zu, sorted triangles: %zu, batches: %zu\n",
+               commands.DrawCount(), commands.LooseTriangleCount(), commands.SortedTriangles(), commands.BatchCount());
+        printf("Mismatches vs immediate: %d (expected 0)\n", mismatches);
+        Check(mismatches == 0, "command buffer vs immediate");
+        // Flat materials merge across draws : at most one batch per material & depth bucket (default 4 bits)
+        Check(commands.BatchCount() <= 16 * 2 && commands.BatchCount() < commands.DrawCount(), "command buffer batching");
+
+        commands.SetDepthBits(2);
+        commands.Execute(sorted, arena.Thread(0));
+        printf("Batches with 2 depth bits: %zu (at most 8)\n", commands.BatchCount());
+        Check(commands.BatchCount() <= 4 * 2, "command buffer batching, 2 depth bits");
+
+    #if defined(SHIKA_ENABLE_STATS)
+        Canvas again(160, 120);
+        Stats::BeginFrame();
+        for (size_t i = 0; i < transforms.size(); i++) {
+            Rasterizer::DrawMesh(again, cube, transforms[i], Color::Red(), arena.Thread(0));
+        }
+        RenderStats immediateStats = Stats::EndFrame();
+        printf("Pixel writes : immediate %llu, sorted %llu\n",
+               (unsigned long long)immediateStats.depthPass, (unsigned long long)sortedStats.depthPass);
+    #endif
+    }
+
+    printf("\n=== Frame Pipeline Test ===\n");
+    {
+        // Frames kept in memory, compared with a synchronous render
+        struct CaptureSink : FrameSink {
+            std::vector<std::vector<uint8_t>> frames;
+            bool WriteFrame(const uint8_t* rgb, int width, int height) override {
+                frames.emplace_back(rgb, rgb + (size_t)width * height * 3);
+                return true;
+            }
+        };
+
+        const int frameCount = 8;
+        Mesh cube = Mesh::CreateCube();
+        Matrix4x4 proj = Matrix4x4::PerspectiveFovLH(ToRadian(60), 4.0f / 3.0f, 0.1f, 100.0f);
+        FrameArena arena(1, 1 << 16);
+        auto renderFrame = [&](Canvas& canvas, int frame) {
+            Matrix4x4 frameMvp = Matrix4x4::RotationY(frame * 0.2f) * Matrix4x4::Translation(Vector3(0, 0, 5.0f)) * proj;
+            arena.Reset();
+            Rasterizer::DrawMesh(canvas, cube, frameMvp, Color::Green(), arena.Thread(0));
+        };
+
+        // Files go to the temp directory and are removed at the end of the test
+        const std::filesystem::path tempDir = std::filesystem::temp_directory_path();
+        const std::string y4mPath = (tempDir / "shika_sequence.y4m").string();
+        auto readFile = [](const std::string& path) {
+            std::ifstream in(path, std::ios::binary);
+            return std::vector<uint8_t>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        };
+
+        CaptureSink capture;
+        Y4mSink y4m(y4mPath, 30, 1, Y4mChroma::C420);
+        bool ok;
+        {
+            FramePipeline pipeline(161, 121, capture, 2);
+            FramePipeline stream(161, 121, y4m, 2);
+            for (int frame = 0; frame < frameCount; frame++) {
+                renderFrame(pipeline.BeginFrame(), frame);
+                pipeline.EndFrame();
+                renderFrame(stream.BeginFrame(), frame);
+                stream.EndFrame();
+            }
+            ok = pipeline.Finish() && stream.Finish();
+            printf("Submitted: %zu, written: %zu, ring: %d, ok: %d\n", pipeline.FramesSubmitted(), pipeline.FramesWritten(), pipeline.RingSize(), ok);
+            Check(ok && pipeline.FramesWritten() == (size_t)frameCount, "frame pipeline writes");
+        }
+
+        int mismatches = 0;
+        std::vector<uint8_t> reference;
+        for (int frame = 0; frame < frameCount && frame < (int)capture.frames.size(); frame++) {
+            Canvas canvas(161, 121);
+            renderFrame(canvas, frame);
+            canvas.ConvertToRGB8(reference);
+            if (reference != capture.frames[frame]) mismatches++;
+        }
+        printf("Frames differing from a synchronous render: %d (expected 0)\n", mismatches);
+        Check(mismatches == 0 && capture.frames.size() == (size_t)frameCount, "frame pipeline vs synchronous render");
+
+        // Header + frameCount * ("FRAME\n" + Y + 2 quarter-size chroma planes)
+        size_t expected = std::string("YUV4MPEG2 W161 H121 F30:1 Ip A1:1 C420jpeg\n").size() + frameCount * (6 + 161 * 121 + 2 * 81 * 61);
+        size_t y4mSize = readFile(y4mPath).size();
+        printf("Y4M size: %zu (expected %zu)\n", y4mSize, expected);
+        Check(y4mSize == expected, "Y4M stream size");
+        std::remove(y4mPath.c_str());
+
+        // Same frames through the PPM sequence & raw video sinks, read back byte for byte
+        if (capture.frames.size() == (size_t)frameCount) {
+            const std::string ppmPattern = (tempDir / "shika_frame_%02d.ppm").string();
+            const std::string rawPath = (tempDir / "shika_sequence.rgb").string();
+            const std::string ppmHeader = "P6\n161 121\n255\n";
+            PpmSequenceSink ppm(ppmPattern);
+            RawVideoSink raw(rawPath);
+            bool written = raw.IsOpen();
+            for (int frame = 0; frame < frameCount; frame++) {
+                written = ppm.WriteFrame(capture.frames[frame].data(), 161, 121) && written;
+                written = raw.WriteFrame(capture.frames[frame].data(), 161, 121) && written;
+            }
+            written = ppm.Finish() && raw.Finish() && written;
+
+            int ppmMismatches = 0;
+            std::vector<uint8_t> rawExpected;
+            for (int frame = 0; frame < frameCount; frame++) {
+                std::vector<char> name(ppmPattern.size() + 32);
+                std::snprintf(name.data(), name.size(), ppmPattern.c_str(), frame);
+                std::vector<uint8_t> expectedPpm(ppmHeader.begin(), ppmHeader.end());
+                expectedPpm.insert(expectedPpm.end(), capture.frames[frame].begin(), capture.frames[frame].end());
+                if (readFile(name.data()) != expectedPpm) ppmMismatches++;
+                std::remove(name.data());
+                rawExpected.insert(rawExpected.end(), capture.frames[frame].begin(), capture.frames[frame].end());
+            }
+            bool rawMatches = readFile(rawPath) == rawExpected;
+            std::remove(rawPath.c_str());
+            printf("PPM frames differing: %d (expected 0), raw video matches: %d\n", ppmMismatches, rawMatches);
+            Check(written && ppmMismatches == 0, "PPM sequence sink");
+            Check(written && rawMatches, "raw video sink");
+        }
+    }
+
+#if defined(SHIKA_ENABLE_STATS)
+    printf("\n=== Render Stats Test ===\n");
+    {
+        Canvas canvas(64, 64);
+        Stats::EnableOverdraw(64, 64);
+        Stats::BeginFrame();
+
+        // Two overlapping triangles (front one drawn last), one backface, one off-screen
+        Rasterizer::DrawFilledTriangle(canvas, {8, 8, 0.8f}, {56, 8, 0.8f}, {8, 56, 0.8f}, Color::Red());
+        Rasterizer::DrawFilledTriangle(canvas, {8, 8, 0.2f}, {56, 8, 0.2f}, {8, 56, 0.2f}, Color::Green());
+        Rasterizer::DrawFilledTriangle(canvas, {8, 8, 0.1f}, {8, 56, 0.1f}, {56, 8, 0.1f}, Color::Blue());
+        Rasterizer::DrawFilledTriangle(canvas, {-30, -30, 0.5f}, {-2, -30, 0.5f}, {-30, -2, 0.5f}, Color::Blue());
+
+        RenderStats stats = Stats::EndFrame();
+        printf("%s\n", stats.ToJson().c_str());
+        printf("Overdraw: %.2f (expected 2.00), Backface: %llu, Frustum: %llu\n", stats.overdraw,
+               (unsigned long long)stats.trianglesCulledBackface, (unsigned long long)stats.trianglesCulledFrustum);
+        Check(std::fabs(stats.overdraw - 2.0) < 0.005, "overdraw");
+
+        Stats::RenderOverdrawHeatmap(canvas);
+
+        // Two threads drawing the same triangle on their own canvas : per-thread counters, summed by EndFrame
+        Stats::BeginFrame();
+        std::vector<std::thread> workers;
+        for (int t = 0; t < 2; t++) {
+            workers.emplace_back([]() {
+                Canvas local(64, 64);
+                Rasterizer::DrawFilledTriangle(local, {8, 8, 0.5f}, {56, 8, 0.5f}, {8, 56, 0.5f}, Color::Red());
+            });
+        }
+        for (auto& w : workers) w.join();
+        RenderStats threaded = Stats::EndFrame();
+        printf("Two threads : overdraw %.2f (expected 2.00), depth pass %llu, touched %llu\n", threaded.overdraw,
+               (unsigned long long)threaded.depthPass, (unsigned long long)threaded.pixelsTouched);
+        Check(std::fabs(threaded.overdraw - 2.0) < 0.005 && threaded.depthPass == 2 * threaded.pixelsTouched, "threaded overdraw");
+        Stats::EnableOverdraw(0, 0);
+    }
+#endif
+
+    printf("\n%d failed check(s)\n", failures);
+    return failures ? 1 : 0;
 }
\ No newline at end of file